@@ -1,19 +1,20 @@
 #pragma once
 
-#include "io/ExcelFile.hpp"
+#include "experiment/ExperimentRunner.hpp"
 #include <Heuro.hpp>
 
+#include <mutex>
+
 class HeuroCli
 {
 private:
-    ExcelFile m_OutputFile;
+    ExperimentSpec m_Spec;
+    std::mutex m_ConsoleMutex;
 
-    void evaluateFile(const std::string &inputFileName);
+    void reportResult(const ResultRecord &record);
 
 public:
-    explicit HeuroCli(const std::string &outputFilename);
+    explicit HeuroCli(const std::string &specFilename);
 
     void run();
 };
-
-
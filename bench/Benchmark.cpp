@@ -0,0 +1,92 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace Bench
+{
+
+    static double percentile(const std::vector<double> &sorted, double p)
+    {
+        double position = p * static_cast<double>(sorted.size() - 1);
+        auto lower = static_cast<size_t>(std::floor(position));
+        size_t upper = std::min(lower + 1, sorted.size() - 1);
+        double weight = position - static_cast<double>(lower);
+        return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+    }
+
+    static void writeJsonString(std::ostream &os, const std::string &text)
+    {
+        os << '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                os << '\\';
+            }
+            os << c;
+        }
+        os << '"';
+    }
+
+    BenchmarkRunner::BenchmarkRunner(BenchmarkOptions options)
+        : m_Options(std::move(options))
+    {
+    }
+
+    bool BenchmarkRunner::isSelected(const std::string &kernel) const
+    {
+        return m_Options.filter.empty() || kernel.find(m_Options.filter) != std::string::npos;
+    }
+
+    void BenchmarkRunner::addResult(BenchmarkResult result, std::vector<double> nanosPerOp)
+    {
+        std::sort(nanosPerOp.begin(), nanosPerOp.end());
+        result.repetitions = static_cast<int>(nanosPerOp.size());
+        result.medianNanos = percentile(nanosPerOp, 0.5);
+        result.p10Nanos = percentile(nanosPerOp, 0.1);
+        result.p90Nanos = percentile(nanosPerOp, 0.9);
+        result.minNanos = nanosPerOp.front();
+        result.opsPerSecond = result.medianNanos > 0.0 ? 1e9 / result.medianNanos : 0.0;
+        m_Results.push_back(std::move(result));
+    }
+
+    void BenchmarkRunner::printTable(std::ostream &os) const
+    {
+        os << std::left << std::setw(48) << "kernel" << std::setw(10) << "instance" << std::right << std::setw(12) << "size"
+           << std::setw(16) << "median ns/op" << std::setw(14) << "p10" << std::setw(14) << "p90" << std::setw(16) << "ops/s" << "  unit\n";
+        for (const BenchmarkResult &result : m_Results)
+        {
+            std::string size = std::to_string(result.rows) + "x" + std::to_string(result.columns);
+            os << std::left << std::setw(48) << result.kernel << std::setw(10) << result.instance << std::right << std::setw(12) << size
+               << std::fixed << std::setprecision(1)
+               << std::setw(16) << result.medianNanos << std::setw(14) << result.p10Nanos << std::setw(14) << result.p90Nanos
+               << std::setw(16) << result.opsPerSecond << "  " << result.unit << '\n';
+        }
+        os.unsetf(std::ios::floatfield);
+    }
+
+    void BenchmarkRunner::writeJson(std::ostream &os, const std::string &revision) const
+    {
+        os << "{\n  \"revision\": ";
+        writeJsonString(os, revision);
+        os << ",\n  \"results\": [";
+        os << std::setprecision(6);
+        for (size_t i = 0; i < m_Results.size(); ++i)
+        {
+            const BenchmarkResult &result = m_Results[i];
+            os << (i ? ",\n    {" : "\n    {") << "\"kernel\": ";
+            writeJsonString(os, result.kernel);
+            os << ", \"instance\": ";
+            writeJsonString(os, result.instance);
+            os << ", \"rows\": " << result.rows << ", \"columns\": " << result.columns << ", \"unit\": ";
+            writeJsonString(os, result.unit);
+            os << ", \"repetitions\": " << result.repetitions << ", \"ops_per_repetition\": " << result.opsPerRepetition
+               << ", \"median_ns\": " << result.medianNanos << ", \"p10_ns\": " << result.p10Nanos << ", \"p90_ns\": " << result.p90Nanos
+               << ", \"min_ns\": " << result.minNanos << ", \"ops_per_sec\": " << result.opsPerSecond << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+
+    /**
+     * @brief Prevents the compiler from optimizing away a value computed by a benchmarked kernel.
+     */
+    template<typename T>
+    inline void keep(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &value;
+#endif
+    }
+
+    struct BenchmarkResult
+    {
+        std::string kernel;
+        std::string instance;
+        int rows = 0; // m
+        int columns = 0; // n
+        std::string unit; // What one operation is, e.g. "check" or "construction"
+        int repetitions = 0;
+        uint64_t opsPerRepetition = 0;
+        double medianNanos = 0.0; // Per operation
+        double p10Nanos = 0.0;
+        double p90Nanos = 0.0;
+        double minNanos = 0.0;
+        double opsPerSecond = 0.0;
+    };
+
+    struct BenchmarkOptions
+    {
+        int warmupRepetitions = 3;
+        int repetitions = 15;
+        double minRepetitionMillis = 20.0; // Operations are batched until one repetition lasts at least this long
+        std::string filter; // Only kernels whose name contains it are run
+    };
+
+    /**
+     * @brief Times kernels with warm-up, batching and repetitions, and reports per-operation percentiles.
+     */
+    class BenchmarkRunner
+    {
+    private:
+        BenchmarkOptions m_Options;
+        std::vector<BenchmarkResult> m_Results;
+
+        void addResult(BenchmarkResult result, std::vector<double> nanosPerOp);
+
+    public:
+        explicit BenchmarkRunner(BenchmarkOptions options);
+
+        bool isSelected(const std::string &kernel) const;
+
+        /**
+         * @brief Benchmarks one kernel on one instance.
+         *
+         * @param kernel The kernel name.
+         * @param instance The instance name.
+         * @param rows The element count of the instance.
+         * @param columns The subset count of the instance.
+         * @param unit What a single call of op stands for.
+         * @param op The operation to time. It is called many times in a row, so it must leave its inputs reusable.
+         */
+        template<typename Op>
+        void run(const std::string &kernel, const std::string &instance, int rows, int columns, const std::string &unit, Op &&op)
+        {
+            if (!isSelected(kernel))
+            {
+                return;
+            }
+
+            using Clock = std::chrono::steady_clock;
+            auto timeBatch = [&op](uint64_t batch)
+            {
+                auto start = Clock::now();
+                for (uint64_t i = 0; i < batch; ++i)
+                {
+                    op();
+                }
+                return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            };
+
+            // calibrate the batch size so that the clock resolution does not matter
+            uint64_t batch = 1;
+            double minNanos = m_Options.minRepetitionMillis * 1e6;
+            for (double elapsed = timeBatch(batch); elapsed < minNanos && batch < (uint64_t(1) << 40); elapsed = timeBatch(batch))
+            {
+                batch *= elapsed > 0.0 ? std::max<uint64_t>(2, std::min<uint64_t>(10, static_cast<uint64_t>(minNanos / elapsed) + 1)) : 10;
+            }
+
+            for (int i = 0; i < m_Options.warmupRepetitions; ++i)
+            {
+                timeBatch(batch);
+            }
+
+            std::vector<double> nanosPerOp;
+            nanosPerOp.reserve(m_Options.repetitions);
+            for (int i = 0; i < m_Options.repetitions; ++i)
+            {
+                nanosPerOp.push_back(timeBatch(batch) / static_cast<double>(batch));
+            }
+
+            BenchmarkResult result;
+            result.kernel = kernel;
+            result.instance = instance;
+            result.rows = rows;
+            result.columns = columns;
+            result.unit = unit;
+            result.opsPerRepetition = batch;
+            addResult(std::move(result), std::move(nanosPerOp));
+        }
+
+        const std::vector<BenchmarkResult> &results() const { return m_Results; }
+
+        void printTable(std::ostream &os) const;
+        void writeJson(std::ostream &os, const std::string &revision) const;
+    };
+
+}
@@ -0,0 +1,195 @@
+#include "ScpBenchmark.hpp"
+
+#include <Scp.hpp>
+#include <util/ScpUtil.hpp>
+#include <util/TournamentTree.hpp>
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+namespace Heuro
+{
+
+    void ScpBenchmark::run(Bench::BenchmarkRunner &runner, const std::string &instanceName, const ScpInput &input)
+    {
+        std::string representation = ScpSolver::create(input)->representation();
+        if (representation == ScpTraitsU16::name()) runKernels<ScpTraitsU16>(runner, instanceName, input);
+        else if (representation == ScpTraitsU16Wide::name()) runKernels<ScpTraitsU16Wide>(runner, instanceName, input);
+        else if (representation == ScpTraitsU16Unicost::name()) runKernels<ScpTraitsU16Unicost>(runner, instanceName, input);
+        else if (representation == ScpTraitsU32::name()) runKernels<ScpTraitsU32>(runner, instanceName, input);
+        else if (representation == ScpTraitsU32Unicost::name()) runKernels<ScpTraitsU32Unicost>(runner, instanceName, input);
+
+        runKernels<ScpTraitsU32Wide>(runner, instanceName, input);
+    }
+
+    template<typename Traits>
+    void ScpBenchmark::runKernels(Bench::BenchmarkRunner &runner, const std::string &instanceName, const ScpInput &input)
+    {
+        using ScpSolution = BasicScpSolution<typename Traits::Index>;
+
+        auto instance = std::make_shared<BasicScpInstance<Traits>>(input.elementCount, input.subsetCount, input.costs, input.relations);
+        BasicScp<Traits> solver(instance);
+        const int m = input.elementCount;
+        const int n = input.subsetCount;
+        const std::string suffix = " [" + Traits::name() + "]";
+
+        ScpSolution solution = solver.graspInternal(1, 1);
+        Bitset solutionBits = Util::vecToBitset(solution.subsets(), n);
+
+        runner.run("isSolutionFeasible" + suffix, instanceName, m, n, "check", [&]
+        {
+            Bench::keep(solver.isSolutionFeasible(solutionBits));
+        });
+
+        runner.run("calculateSolutionCost" + suffix, instanceName, m, n, "evaluation", [&]
+        {
+            Bench::keep(solver.calculateSolutionCost(solutionBits));
+        });
+
+        // the sparse relations against the dense matrix with every available kernel, whichever one the solver picked
+        auto sparseInstance = std::make_shared<BasicScpInstance<Traits>>(*instance);
+        sparseInstance->m_DenseCoverage.reset();
+        BasicScp<Traits> sparseSolver(sparseInstance);
+        runner.run("isSolutionFeasible/sparse" + suffix, instanceName, m, n, "check", [&]
+        {
+            Bench::keep(sparseSolver.isSolutionFeasible(solutionBits));
+        });
+        runner.run("calculateSolutionCost/sparse" + suffix, instanceName, m, n, "evaluation", [&]
+        {
+            Bench::keep(sparseSolver.calculateSolutionCost(solutionBits));
+        });
+
+        std::vector<CoverageMatrix::Kernel> kernels{ CoverageMatrix::Kernel::Scalar };
+        if (CoverageMatrix::bestKernel() == CoverageMatrix::Kernel::Avx2)
+        {
+            kernels.push_back(CoverageMatrix::Kernel::Avx2);
+        }
+        for (CoverageMatrix::Kernel kernel : kernels)
+        {
+            const CoverageMatrix dense = instance->makeDenseCoverage(kernel);
+            const std::string denseSuffix = std::string("/dense-") + CoverageMatrix::kernelName(kernel) + suffix;
+            runner.run("isSolutionFeasible" + denseSuffix, instanceName, m, n, "check", [&]
+            {
+                Bench::keep(dense.coversAll(solutionBits));
+            });
+            runner.run("uncoveredCount" + denseSuffix, instanceName, m, n, "check", [&]
+            {
+                Bench::keep(dense.uncoveredCount(solutionBits));
+            });
+            runner.run("calculateSolutionCost" + denseSuffix, instanceName, m, n, "evaluation", [&]
+            {
+                Bench::keep(dense.cost(solutionBits));
+            });
+        }
+
+        ScpSolution constructed(m, n);
+        runner.run("greedyRandomized(k=10)" + suffix, instanceName, m, n, "construction", [&]
+        {
+            solver.greedyRandomized(constructed, 10, 0, solver.m_Scratch);
+            solver.m_Scratch.reset();
+            Bench::keep(constructed.cost());
+        });
+
+        {
+            TournamentTree<int> candidates;
+            candidates.assign(input.costs);
+            std::pmr::vector<int> indices;
+            runner.run("TournamentTree::smallest(k=10)" + suffix, instanceName, m, n, "selection", [&]
+            {
+                candidates.smallest(10, indices);
+                Bench::keep(indices[0]);
+            });
+        }
+
+        // the neighbourhoods edit in place, so every operation starts again from a copy of the same solution
+        ScpSolution neighbour = solution;
+        runner.run("randomNeighbour" + suffix, instanceName, m, n, "neighbour", [&]
+        {
+            neighbour = solution;
+            solver.randomNeighbour(neighbour);
+            Bench::keep(neighbour.cost());
+        });
+
+        runner.run("flipNeighbour" + suffix, instanceName, m, n, "neighbour", [&]
+        {
+            neighbour = solution;
+            solver.flipNeighbour(neighbour);
+            Bench::keep(neighbour.cost());
+        });
+
+        runner.run("sequentialRemovalNeighbour" + suffix, instanceName, m, n, "neighbourhood", [&]
+        {
+            neighbour = solution;
+            solver.sequentialRemovalNeighbour(neighbour);
+            Bench::keep(neighbour.cost());
+        });
+
+        runner.run("bestNeighbour" + suffix, instanceName, m, n, "neighbourhood", [&]
+        {
+            neighbour = solution;
+            solver.bestNeighbour(neighbour);
+            Bench::keep(neighbour.cost());
+        });
+
+        // BLGA operators over a population built like Scp::blga does
+        constexpr int POPULATION_SIZE = 300;
+        constexpr int MATES_COUNT = 10;
+        constexpr int RTS_SAMPLE_SIZE = 50;
+        BlgaIndividual leader{ solutionBits };
+        solver.evaluateIndividual(leader);
+        std::vector<BlgaIndividual> population;
+        std::unordered_map<uint64_t, int> populationHashes;
+        population.reserve(POPULATION_SIZE);
+        for (int i = 0; i < POPULATION_SIZE; ++i)
+        {
+            BlgaIndividual individual{ Util::genRandomBitset(n, 0.5) };
+            solver.evaluateIndividual(individual);
+            populationHashes[individual.hash] += 1;
+            population.push_back(std::move(individual));
+        }
+
+        runner.run("positiveAssortativeMating" + suffix, instanceName, m, n, "selection", [&]
+        {
+            {
+                std::pmr::vector<int> mates = solver.positiveAssortativeMating(leader.genes, population, MATES_COUNT);
+                Bench::keep(mates[0]);
+            }
+            solver.m_Scratch.reset();
+        });
+
+        std::pmr::vector<int> mates(solver.positiveAssortativeMating(leader.genes, population, MATES_COUNT), std::pmr::get_default_resource());
+        solver.m_Scratch.reset();
+        BlgaIndividual offspring{ Bitset(n) };
+        runner.run("randomParentUniformCrossover" + suffix, instanceName, m, n, "offspring", [&]
+        {
+            solver.randomParentUniformCrossover(leader, population, mates, 0.8, offspring);
+            Bench::keep(offspring.genes.words()[0]);
+        });
+
+        runner.run("evaluateIndividual" + suffix, instanceName, m, n, "evaluation", [&]
+        {
+            solver.evaluateIndividual(offspring);
+            Bench::keep(offspring.cost);
+        });
+
+        // every call after the first one hits the cache, so this times the lookup that replaces a repeated evaluation (the
+        // crossover already derived the offspring's hash)
+        solver.setEvaluationCache(std::make_shared<EvaluationCache>());
+        runner.run("evaluateIndividualCached" + suffix, instanceName, m, n, "evaluation", [&]
+        {
+            solver.evaluateIndividualCached(offspring);
+            Bench::keep(offspring.cost);
+        });
+
+        // the population only changes when the solution beats the closest drafted individual, keep it as it is
+        BlgaIndividual worst = leader;
+        worst.cost = std::numeric_limits<int>::max();
+        worst.feasible = false;
+        runner.run("restrictedTournamentSelection" + suffix, instanceName, m, n, "selection", [&]
+        {
+            solver.restrictedTournamentSelection(population, populationHashes, worst, RTS_SAMPLE_SIZE);
+        });
+    }
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Benchmark.hpp"
+
+#include <util/Data.hpp>
+
+#include <string>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Registers the core SCP kernels of a single instance with a benchmark runner.
+     */
+    class ScpBenchmark
+    {
+    private:
+        template<typename Traits>
+        static void runKernels(Bench::BenchmarkRunner &runner, const std::string &instanceName, const ScpInput &input);
+
+    public:
+        /**
+         * @brief Times the kernels both with the representation picked by ScpSolver::create and with the widest one.
+         */
+        static void run(Bench::BenchmarkRunner &runner, const std::string &instanceName, const ScpInput &input);
+    };
+
+}
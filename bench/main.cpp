@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+#include "ScpBenchmark.hpp"
+
+#include <util/ScpParser.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static const char *USAGE =
+    "Usage: heuro_bench [options]\n"
+    "  --instances a,b,...   Instances to load from the assets directory (default: every bundled one)\n"
+    "  --assets <dir>        Directory holding the instance files (default: assets)\n"
+    "  --filter <text>       Only run the kernels whose name contains text\n"
+    "  --repetitions <n>     Measured repetitions per kernel (default: 15)\n"
+    "  --warmup <n>          Warm-up repetitions per kernel (default: 3)\n"
+    "  --min-time <ms>       Minimum duration of one repetition (default: 20)\n"
+    "  --json <file>         Also write the results as JSON, to diff between revisions\n"
+    "  --revision <text>     Revision label stored in the JSON output\n"
+    "  --quick               Shortcut for --repetitions 5 --warmup 1 --min-time 5\n";
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> instances = {
+        "scp41", "scp42",
+        "scpnrg1", "scpnrg2", "scpnrg3", "scpnrg4", "scpnrg5",
+        "scpnrh1", "scpnrh2", "scpnrh3", "scpnrh4", "scpnrh5"
+    };
+    std::string assetsDir = "assets";
+    std::string jsonPath;
+    std::string revision = "unknown";
+    Bench::BenchmarkOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << arg << '\n' << USAGE;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--instances")
+        {
+            instances.clear();
+            std::stringstream list(nextValue());
+            for (std::string name; std::getline(list, name, ',');)
+            {
+                instances.push_back(name);
+            }
+        }
+        else if (arg == "--assets") assetsDir = nextValue();
+        else if (arg == "--filter") options.filter = nextValue();
+        else if (arg == "--repetitions") options.repetitions = std::stoi(nextValue());
+        else if (arg == "--warmup") options.warmupRepetitions = std::stoi(nextValue());
+        else if (arg == "--min-time") options.minRepetitionMillis = std::stod(nextValue());
+        else if (arg == "--json") jsonPath = nextValue();
+        else if (arg == "--revision") revision = nextValue();
+        else if (arg == "--quick")
+        {
+            options.repetitions = 5;
+            options.warmupRepetitions = 1;
+            options.minRepetitionMillis = 5.0;
+        }
+        else
+        {
+            std::cerr << USAGE;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    Bench::BenchmarkRunner runner(options);
+    for (const std::string &instance : instances)
+    {
+        std::string path = assetsDir + "/" + instance + ".txt";
+        if (!std::ifstream(path).is_open())
+        {
+            std::cerr << "Could not open " << path << ", skipping\n";
+            continue;
+        }
+
+        Heuro::ScpInput input = Heuro::ScpParser::parseFile(path);
+        std::cerr << "Benchmarking " << instance << " (" << input.elementCount << "x" << input.subsetCount << ")\n";
+        Heuro::ScpBenchmark::run(runner, instance, input);
+    }
+
+    runner.printTable(std::cout);
+    if (!jsonPath.empty())
+    {
+        std::ofstream json(jsonPath);
+        runner.writeJson(json, revision);
+    }
+
+    return 0;
+}
@@ -0,0 +1,305 @@
+#include "ExperimentRunner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+ExperimentRunner::ExperimentRunner(ExperimentSpec spec, ResultSink &sink, ResultCallback onResult)
+    : m_Spec(std::move(spec)), m_Sink(sink), m_OnResult(std::move(onResult))
+{
+}
+
+std::unordered_set<std::string> ExperimentRunner::readFinishedJobs() const
+{
+    std::unordered_set<std::string> finishedJobs;
+    for (const ResultRecord &record : StreamingResultSink::readRecords(m_Spec.outputPath))
+    {
+        finishedJobs.insert(record.key());
+    }
+    return finishedJobs;
+}
+
+std::string ExperimentRunner::solutionsPath(const std::string &instance) const
+{
+    return m_Spec.solutionsDir + "/" + instance + ".sol";
+}
+
+std::vector<Heuro::ScpResult> ExperimentRunner::readSolutions(const std::string &instance) const
+{
+    if (m_Spec.solutionsDir.empty() || !std::filesystem::exists(solutionsPath(instance)))
+    {
+        return {};
+    }
+    return Heuro::ScpSolutionFile::read(solutionsPath(instance));
+}
+
+std::string ExperimentRunner::checkpointPath(const ExperimentJob &job) const
+{
+    std::string name = job.instance + '_' + job.config.algorithm + '_' + job.config.paramsKey() + '_' + std::to_string(job.seed);
+    std::replace_if(name.begin(), name.end(), [](char c) { return c == '/' || c == '\\' || std::isspace(static_cast<unsigned char>(c)); }, '_');
+    return m_Spec.checkpointsDir + "/" + name + ".ckpt";
+}
+
+void ExperimentRunner::storeSolutions(const std::string &instance, std::vector<Heuro::ScpResult> solutions) const
+{
+    constexpr size_t STORED_SOLUTIONS = 10; // Enough to seed part of a BLGA population
+
+    std::stable_sort(solutions.begin(), solutions.end(),
+        [](const Heuro::ScpResult &a, const Heuro::ScpResult &b) { return a.cost < b.cost; });
+    std::vector<Heuro::ScpResult> stored;
+    for (Heuro::ScpResult &solution : solutions)
+    {
+        bool isDuplicate = std::any_of(stored.begin(), stored.end(),
+            [&solution](const Heuro::ScpResult &other) { return other.subsetIDs == solution.subsetIDs; });
+        if (!isDuplicate && stored.size() < STORED_SOLUTIONS)
+        {
+            stored.push_back(std::move(solution));
+        }
+    }
+
+    std::filesystem::create_directories(m_Spec.solutionsDir);
+    Heuro::ScpSolutionFile::write(solutionsPath(instance), stored);
+}
+
+Heuro::ScpResult ExperimentRunner::runAlgorithm(Heuro::ScpSolver &solver, const AlgorithmConfig &config) const
+{
+    long maxRuntime = config.params.count("maxRuntime") ? std::stol(config.param("maxRuntime")) : m_Spec.timeBudgetMillis;
+    if (config.params.count("coreColumnsPerRow"))
+    {
+        int pricingRounds = config.params.count("pricingRounds") ? std::stoi(config.param("pricingRounds")) : 5;
+        return solver.coreProblem(maxRuntime, std::stoi(config.param("coreColumnsPerRow")), pricingRounds,
+            [this, &config](Heuro::ScpSolver &core, long roundRuntime) { return runAlgorithm(core, config, roundRuntime); });
+    }
+    return runAlgorithm(solver, config, maxRuntime);
+}
+
+Heuro::ScpResult ExperimentRunner::runAlgorithm(Heuro::ScpSolver &solver, const AlgorithmConfig &config, long maxRuntime) const
+{
+    auto intParam = [&config](const std::string &name) { return std::stoi(config.param(name)); };
+    auto realParam = [&config](const std::string &name) { return std::stod(config.param(name)); };
+
+    const std::string &algorithm = config.algorithm;
+    if (algorithm == "constructive")
+    {
+        return solver.constructive();
+    }
+    if (algorithm == "grasp")
+    {
+        return solver.grasp(intParam("maxSolCount"), intParam("k"));
+    }
+    if (algorithm == "graspWithNoise")
+    {
+        return solver.graspWithNoise(intParam("maxSolCount"), intParam("k"), intParam("rho"));
+    }
+    if (algorithm == "simulatedAnnealing")
+    {
+        // "linear:<rate>" cools as t0 - rate * k, "exp" as t0 * e^-k
+        std::string cooling = config.param("cooling");
+        std::function<double(double, int)> schedule;
+        if (cooling == "exp")
+        {
+            schedule = [](double t0, int k) { return t0 * std::exp(-k); };
+        }
+        else if (cooling.rfind("linear:", 0) == 0)
+        {
+            double rate = std::stod(cooling.substr(7));
+            schedule = [rate](double t0, int k) { return t0 - rate * k; };
+        }
+        else
+        {
+            throw std::runtime_error("Unknown cooling schedule '" + cooling + "'");
+        }
+        return solver.simulatedAnnealing(maxRuntime, realParam("initTemp"), intParam("iterPerTemp"), schedule);
+    }
+    if (algorithm == "vns")
+    {
+        return solver.vns(maxRuntime);
+    }
+    if (algorithm == "blga")
+    {
+        return solver.blga(
+            maxRuntime, intParam("populationSize"), intParam("matesCount"), realParam("geneCopyProbability"), intParam("rtsSampleSize"));
+    }
+    if (algorithm == "branchAndBound")
+    {
+        long maxNodes = config.params.count("maxNodes") ? std::stol(config.param("maxNodes")) : 0;
+        int threadCount = config.params.count("threads") ? std::stoi(config.param("threads")) : 1;
+        return solver.branchAndBound(maxRuntime, maxNodes, threadCount).solution;
+    }
+    throw std::runtime_error("Unknown algorithm '" + algorithm + "'");
+}
+
+size_t ExperimentRunner::run()
+{
+    std::unordered_set<std::string> finishedJobs = readFinishedJobs();
+    std::vector<ExperimentJob> jobs;
+    for (ExperimentJob &job : m_Spec.jobs())
+    {
+        if (!finishedJobs.count(job.key()))
+        {
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    // every job on the same instance shares its read-only instance, its evaluation cache and its warm starts
+    std::map<std::string, std::shared_ptr<const Heuro::ScpInstance>> instances;
+    std::map<std::string, std::shared_ptr<Heuro::EvaluationCache>> caches;
+    std::map<std::string, std::vector<Heuro::ScpResult>> solutions;
+    std::map<std::string, std::unique_ptr<Heuro::IncumbentBoard>> boards;
+    for (const ExperimentJob &job : jobs)
+    {
+        if (!instances.count(job.instance))
+        {
+            const auto &instance = instances[job.instance] = Heuro::ScpInstance::create(Heuro::ScpParser::parseFile(m_Spec.instancePath(job.instance)));
+            caches[job.instance] = std::make_shared<Heuro::EvaluationCache>();
+            solutions[job.instance] = readSolutions(job.instance);
+            if (!m_Spec.incumbentBoard.empty())
+            {
+                boards[job.instance] = std::make_unique<Heuro::IncumbentBoard>(
+                    Heuro::IncumbentBoard::segmentName(m_Spec.incumbentBoard, job.instance), instance->elementCount(), instance->subsetCount());
+            }
+        }
+    }
+    const std::map<std::string, std::vector<Heuro::ScpResult>> initialSolutions = solutions;
+    if (!m_Spec.checkpointsDir.empty())
+    {
+        std::filesystem::create_directories(m_Spec.checkpointsDir);
+    }
+    std::mutex solutionsMutex;
+
+    unsigned int workerCount = m_Spec.parallelism > 0 ? m_Spec.parallelism : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<unsigned int>(workerCount, std::max<size_t>(jobs.size(), 1));
+
+    // the solvers run their own parallel work on the same pool as the jobs, so nothing oversubscribes the machine
+    Heuro::Executor executor(workerCount);
+    std::atomic<bool> failed = false;
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+    auto runJob = [&](const ExperimentJob &job)
+    {
+        if (failed)
+        {
+            return;
+        }
+
+        try
+        {
+            std::unique_ptr<Heuro::ScpSolver> solver = Heuro::ScpSolver::create(instances.at(job.instance));
+            solver->setEvaluationCache(caches.at(job.instance));
+            solver->setExecutor(&executor);
+            solver->setInitialSolutions(initialSolutions.at(job.instance));
+            if (!boards.empty())
+            {
+                solver->setIncumbentBoard(boards.at(job.instance).get());
+            }
+            if (!m_Spec.checkpointsDir.empty())
+            {
+                solver->setCheckpoint(checkpointPath(job), m_Spec.checkpointIntervalMillis);
+            }
+
+            // a sample interval this long only keeps the improvements
+            std::optional<Heuro::ConvergenceTrace> trace;
+            if (m_RecordImprovements)
+            {
+                trace.emplace(std::numeric_limits<long>::max());
+                trace->beginRun(job.label());
+                solver->setConvergenceTrace(&*trace);
+            }
+
+            Heuro::ScpResult result;
+            auto start = std::chrono::steady_clock::now();
+            {
+                Heuro::RandomSeed::Scope seed(job.seed);
+                HE_PROFILE_SCOPE(job.label());
+                result = runAlgorithm(*solver, job.config);
+            }
+            double wallMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            ResultRecord record{
+                .instance = job.instance,
+                .algorithm = job.config.algorithm,
+                .params = job.config.paramsKey(),
+                .seed = job.seed,
+                .cost = result.cost,
+                .subsetCount = result.subsetCount,
+                .wallMillis = wallMillis,
+                .evaluations = {},
+                .subsets = {},
+                .improvements = {},
+            };
+            if (Heuro::SearchStats::ENABLED)
+            {
+                const Heuro::SearchStats &stats = solver->lastRunStats();
+                record.evaluations = stats.movesProposed + stats.restarts;
+            }
+            record.subsets.assign(result.subsetIDs.begin(), result.subsetIDs.end());
+            std::sort(record.subsets.begin(), record.subsets.end());
+            if (trace)
+            {
+                for (const Heuro::ConvergencePoint &point : trace->points())
+                {
+                    if (record.improvements.empty() || point.bestCost < record.improvements.back().bestCost)
+                    {
+                        record.improvements.push_back({ point.elapsedMillis, point.bestCost });
+                    }
+                }
+            }
+
+            if (!m_Spec.solutionsDir.empty())
+            {
+                std::lock_guard lock(solutionsMutex);
+                solutions[job.instance].push_back(std::move(result));
+            }
+
+            if (m_OnResult)
+            {
+                m_OnResult(record);
+            }
+            m_Sink.write(std::move(record));
+        }
+        catch (...)
+        {
+            // skip the jobs not started yet, the ones finished so far are kept for resuming
+            failed = true;
+            std::lock_guard lock(errorMutex);
+            if (!firstError)
+            {
+                firstError = std::current_exception();
+            }
+        }
+    };
+
+    {
+        Heuro::TaskGroup group(executor);
+        for (const ExperimentJob &job : jobs)
+        {
+            group.spawn([&runJob, &job]() { runJob(job); });
+        }
+        group.wait();
+    }
+    m_Sink.flush();
+
+    if (!m_Spec.solutionsDir.empty())
+    {
+        for (auto &[instance, instanceSolutions] : solutions)
+        {
+            storeSolutions(instance, std::move(instanceSolutions));
+        }
+    }
+
+    if (firstError)
+    {
+        std::rethrow_exception(firstError);
+    }
+    return jobs.size();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ExperimentSpec.hpp"
+#include "ResultSink.hpp"
+
+#include <Heuro.hpp>
+
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Runs every job of an experiment spec on an executor sized to the spec's parallelism, which the solvers also use for
+ * their own parallel work. Each job gets its own solver and seeds the random generators of the thread running it with the
+ * job's seed, so results are reproducible regardless of the parallelism.
+ * Every finished job is handed to the result sink right away; running the same spec again skips the jobs already stored
+ * in the spec's output, so an interrupted experiment resumes where it left off.
+ * If the spec names a solutions directory, every job warm starts from the solutions stored there for its instance, and the
+ * best ones found are stored back once the jobs end, so the next run continues from them.
+ * If the spec names a checkpoints directory, the time-bounded jobs also save their state there while they run, and a job
+ * interrupted by the end of its process continues from its checkpoint instead of starting over.
+ * If the spec names an incumbent board, the jobs of each instance also share their best solution while they run, with each
+ * other and with every other process attached to the same board (see Heuro::IncumbentBoard).
+ */
+class ExperimentRunner
+{
+public:
+    using ResultCallback = std::function<void(const ResultRecord &)>;
+
+private:
+    ExperimentSpec m_Spec;
+    ResultSink &m_Sink;
+    ResultCallback m_OnResult;
+    bool m_RecordImprovements = false;
+
+    std::unordered_set<std::string> readFinishedJobs() const;
+
+    std::string solutionsPath(const std::string &instance) const;
+    std::vector<Heuro::ScpResult> readSolutions(const std::string &instance) const;
+
+    std::string checkpointPath(const ExperimentJob &job) const;
+
+    /**
+     * @brief Replaces the stored solutions of an instance with the cheapest distinct ones among the given.
+     */
+    void storeSolutions(const std::string &instance, std::vector<Heuro::ScpResult> solutions) const;
+    /**
+     * @brief Runs the configured algorithm, on a core problem if the config sets coreColumnsPerRow (and optionally pricingRounds).
+     */
+    Heuro::ScpResult runAlgorithm(Heuro::ScpSolver &solver, const AlgorithmConfig &config) const;
+    Heuro::ScpResult runAlgorithm(Heuro::ScpSolver &solver, const AlgorithmConfig &config, long maxRuntime) const;
+
+public:
+    /**
+     * @param sink Receives the results. It should append to the spec's output, where finished jobs are looked up.
+     * @param onResult Called with every finished job from the worker that ran it, so it may be called concurrently.
+     */
+    ExperimentRunner(ExperimentSpec spec, ResultSink &sink, ResultCallback onResult = {});
+
+    /**
+     * @brief Whether every job traces its run in memory and fills ResultRecord::improvements, to tell when it reached a
+     * given cost. Off by default.
+     */
+    void setRecordImprovements(bool record) { m_RecordImprovements = record; }
+
+    /**
+     * @return The amount of jobs run, which excludes those found already finished in the output.
+     */
+    size_t run();
+};
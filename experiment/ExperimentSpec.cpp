@@ -0,0 +1,208 @@
+#include "ExperimentSpec.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static std::string trim(const std::string &text)
+{
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static std::vector<std::string> splitList(const std::string &text)
+{
+    std::vector<std::string> values;
+    std::stringstream list(text);
+    for (std::string value; std::getline(list, value, ',');)
+    {
+        value = trim(value);
+        if (!value.empty())
+        {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+static void expandGrid(
+    const std::string &algorithm,
+    const std::vector<std::pair<std::string, std::vector<std::string>>> &grid,
+    std::vector<AlgorithmConfig> &configs)
+{
+    std::vector<AlgorithmConfig> expanded = { AlgorithmConfig{ algorithm, {} } };
+    for (const auto &[name, values] : grid)
+    {
+        std::vector<AlgorithmConfig> next;
+        next.reserve(expanded.size() * values.size());
+        for (const AlgorithmConfig &config : expanded)
+        {
+            for (const std::string &value : values)
+            {
+                AlgorithmConfig extended = config;
+                extended.params[name] = value;
+                next.push_back(std::move(extended));
+            }
+        }
+        expanded = std::move(next);
+    }
+    configs.insert(configs.end(), expanded.begin(), expanded.end());
+}
+
+std::string AlgorithmConfig::paramsKey() const
+{
+    std::string key;
+    for (const auto &[name, value] : params)
+    {
+        if (!key.empty())
+        {
+            key += ';';
+        }
+        key += name + '=' + value;
+    }
+    return key;
+}
+
+std::string AlgorithmConfig::param(const std::string &name) const
+{
+    auto it = params.find(name);
+    if (it == params.end())
+    {
+        throw std::runtime_error("Missing parameter '" + name + "' for algorithm " + algorithm);
+    }
+    return it->second;
+}
+
+std::string ExperimentJob::key() const
+{
+    return instance + ',' + config.algorithm + ',' + config.paramsKey() + ',' + std::to_string(seed);
+}
+
+std::string ExperimentJob::label() const
+{
+    return instance + '\t' + config.algorithm + '_' + config.paramsKey() + "__" + std::to_string(seed);
+}
+
+ExperimentSpec ExperimentSpec::parseFile(const std::string &filename)
+{
+    std::ifstream inputFile(filename);
+    if (!inputFile.is_open())
+    {
+        throw std::runtime_error("Could not open experiment spec " + filename);
+    }
+
+    ExperimentSpec spec;
+    int repetitions = 1;
+    uint32_t baseSeed = 1;
+    std::string currentAlgorithm;
+    std::vector<std::pair<std::string, std::vector<std::string>>> currentGrid;
+    auto flushSection = [&]()
+    {
+        if (!currentAlgorithm.empty())
+        {
+            expandGrid(currentAlgorithm, currentGrid, spec.configs);
+        }
+        currentGrid.clear();
+    };
+
+    int lineNumber = 0;
+    for (std::string line; std::getline(inputFile, line);)
+    {
+        lineNumber += 1;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+        {
+            continue;
+        }
+
+        if (line.front() == '[' && line.back() == ']')
+        {
+            flushSection();
+            currentAlgorithm = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == std::string::npos)
+        {
+            throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": expected 'name = value'");
+        }
+        std::string name = trim(line.substr(0, separator));
+        std::string value = trim(line.substr(separator + 1));
+
+        if (!currentAlgorithm.empty())
+        {
+            currentGrid.emplace_back(name, splitList(value));
+        }
+        else if (name == "assets") spec.assetsDir = value;
+        else if (name == "output") spec.outputPath = value;
+        else if (name == "parallelism") spec.parallelism = std::stoi(value);
+        else if (name == "time_budget_ms") spec.timeBudgetMillis = std::stol(value);
+        else if (name == "solutions") spec.solutionsDir = value;
+        else if (name == "incumbent_board") spec.incumbentBoard = value;
+        else if (name == "checkpoints") spec.checkpointsDir = value;
+        else if (name == "checkpoint_interval_ms") spec.checkpointIntervalMillis = std::stol(value);
+        else if (name == "instances") spec.instances = splitList(value);
+        else if (name == "repetitions") repetitions = std::stoi(value);
+        else if (name == "seed") baseSeed = static_cast<uint32_t>(std::stoul(value));
+        else if (name == "seeds")
+        {
+            for (const std::string &seed : splitList(value))
+            {
+                spec.seeds.push_back(static_cast<uint32_t>(std::stoul(seed)));
+            }
+        }
+        else
+        {
+            throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": unknown setting '" + name + "'");
+        }
+    }
+    flushSection();
+
+    if (spec.seeds.empty())
+    {
+        for (int i = 0; i < repetitions; ++i)
+        {
+            spec.seeds.push_back(baseSeed + i);
+        }
+    }
+
+    // a misspelled instance fails here rather than once its jobs are scheduled
+    for (const std::string &instance : spec.instances)
+    {
+        if (!std::filesystem::is_regular_file(spec.instancePath(instance)))
+        {
+            throw std::runtime_error(filename + ": instance " + instance + " is not in the assets (" + spec.instancePath(instance) + ")");
+        }
+    }
+
+    return spec;
+}
+
+std::string ExperimentSpec::instancePath(const std::string &instance) const
+{
+    return assetsDir + "/" + instance + ".txt";
+}
+
+std::vector<ExperimentJob> ExperimentSpec::jobs() const
+{
+    std::vector<ExperimentJob> jobs;
+    jobs.reserve(instances.size() * configs.size() * seeds.size());
+    for (const std::string &instance : instances)
+    {
+        for (const AlgorithmConfig &config : configs)
+        {
+            for (uint32_t seed : seeds)
+            {
+                jobs.push_back({ instance, config, seed });
+            }
+        }
+    }
+    return jobs;
+}
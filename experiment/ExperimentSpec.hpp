@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One algorithm with a fixed value for each of its parameters.
+ */
+struct AlgorithmConfig
+{
+    std::string algorithm;
+    std::map<std::string, std::string> params;
+
+    /**
+     * @brief Canonical text of the parameters (name=value pairs sorted by name, separated by ';').
+     */
+    std::string paramsKey() const;
+
+    std::string param(const std::string &name) const;
+};
+
+/**
+ * @brief A single independent run: one configuration on one instance with one seed.
+ */
+struct ExperimentJob
+{
+    std::string instance;
+    AlgorithmConfig config;
+    uint32_t seed = 0;
+
+    /**
+     * @brief Identifies the job among the stored results, so finished jobs can be skipped when resuming.
+     */
+    std::string key() const;
+    std::string label() const;
+};
+
+/**
+ * @brief Description of an experiment, read from a spec file like:
+ *
+ *     assets = assets
+ *     output = results.csv     # or results.jsonl for JSON Lines
+ *     parallelism = 4          # 0 uses every core
+ *     time_budget_ms = 300000  # default maxRuntime of the time-bounded algorithms
+ *     instances = scp41, scp42
+ *     seeds = 1, 2, 3          # or: repetitions = 3 and seed = 1 (seeds 1, 2, 3)
+ *     solutions = solutions    # optional, warm starts every job from <dir>/<instance>.sol and stores the best ones back
+ *     incumbent_board = heuro  # optional, shares the best solution of each instance with other processes (see below)
+ *     checkpoints = checkpoints      # optional, SA, VNS and BLGA jobs save their state to <dir> and resume from it
+ *     checkpoint_interval_ms = 60000 # how often they do, 60000 by default
+ *
+ *     [blga]
+ *     populationSize = 300, 150
+ *     matesCount = 10
+ *     geneCopyProbability = 0.8, 0.65
+ *     rtsSampleSize = 50
+ *
+ * Every algorithm section lists comma separated values per parameter, and the cartesian product of them is run.
+ * The same algorithm may appear in several sections to describe grids that are not full products. Any algorithm runs on a
+ * core problem (see Scp::coreProblem) when its section sets coreColumnsPerRow, and optionally pricingRounds.
+ * With incumbent_board, the jobs of every process whose spec names the same board cooperate on each instance through the
+ * shared memory segment /<board>.<instance> (see Heuro::IncumbentBoard). The segment keeps its solution after the processes
+ * exit, so later runs continue from it until it is removed (e.g. rm /dev/shm/heuro.scp41 on Linux).
+ */
+struct ExperimentSpec
+{
+    std::string assetsDir = "assets";
+    std::string outputPath = "results.csv";
+    int parallelism = 0;
+    long timeBudgetMillis = 300000;
+    std::string solutionsDir; // Empty to start every job cold
+    std::string incumbentBoard; // Prefix of the shared memory segments, empty to solve every instance alone
+    std::string checkpointsDir; // Empty to run every job from its start
+    long checkpointIntervalMillis = 60000;
+    std::vector<std::string> instances;
+    std::vector<uint32_t> seeds;
+    std::vector<AlgorithmConfig> configs; // Already expanded from the parameter grids
+
+    /**
+     * @throws std::runtime_error If the file can not be read, is malformed or names an instance missing from the assets.
+     */
+    static ExperimentSpec parseFile(const std::string &filename);
+
+    /**
+     * @brief The file of an instance in the assets directory.
+     */
+    std::string instancePath(const std::string &instance) const;
+
+    std::vector<ExperimentJob> jobs() const;
+};
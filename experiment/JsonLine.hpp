@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cctype>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Writes text as a quoted JSON string.
+ */
+inline void writeJsonString(std::ostream &os, const std::string &text)
+{
+    os << '"';
+    for (char c : text)
+    {
+        switch (c)
+        {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            default: os << c; break;
+        }
+    }
+    os << '"';
+}
+
+/**
+ * @brief Reads the flat JSON objects written one per line by heuro's tools (see StreamingResultSink): string, number and null
+ * values, and arrays of numbers.
+ */
+class JsonLineReader
+{
+private:
+    const std::string &m_Line;
+    size_t m_Pos = 0;
+
+    void skipSpaces()
+    {
+        while (m_Pos < m_Line.size() && std::isspace(static_cast<unsigned char>(m_Line[m_Pos])))
+        {
+            m_Pos += 1;
+        }
+    }
+
+    void expect(char c)
+    {
+        skipSpaces();
+        if (m_Pos >= m_Line.size() || m_Line[m_Pos] != c)
+        {
+            throw std::runtime_error(std::string("Expected '") + c + "' in JSON line: " + m_Line);
+        }
+        m_Pos += 1;
+    }
+
+    bool consume(char c)
+    {
+        skipSpaces();
+        if (m_Pos < m_Line.size() && m_Line[m_Pos] == c)
+        {
+            m_Pos += 1;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    explicit JsonLineReader(const std::string &line)
+        : m_Line(line)
+    {
+    }
+
+    std::string readString()
+    {
+        expect('"');
+        std::string text;
+        while (m_Pos < m_Line.size() && m_Line[m_Pos] != '"')
+        {
+            char c = m_Line[m_Pos++];
+            if (c == '\\' && m_Pos < m_Line.size())
+            {
+                c = m_Line[m_Pos++];
+                c = c == 'n' ? '\n' : c == 't' ? '\t' : c;
+            }
+            text += c;
+        }
+        expect('"');
+        return text;
+    }
+
+    /**
+     * @return The raw text of a number or null value.
+     */
+    std::string readScalar()
+    {
+        skipSpaces();
+        size_t begin = m_Pos;
+        while (m_Pos < m_Line.size() && m_Line[m_Pos] != ',' && m_Line[m_Pos] != '}' && m_Line[m_Pos] != ']' && !std::isspace(static_cast<unsigned char>(m_Line[m_Pos])))
+        {
+            m_Pos += 1;
+        }
+        return m_Line.substr(begin, m_Pos - begin);
+    }
+
+    std::vector<int> readIntArray()
+    {
+        std::vector<int> values;
+        expect('[');
+        if (consume(']'))
+        {
+            return values;
+        }
+        do
+        {
+            values.push_back(std::stoi(readScalar()));
+        } while (consume(','));
+        expect(']');
+        return values;
+    }
+
+    std::vector<double> readDoubleArray()
+    {
+        std::vector<double> values;
+        expect('[');
+        if (consume(']'))
+        {
+            return values;
+        }
+        do
+        {
+            values.push_back(std::stod(readScalar()));
+        } while (consume(','));
+        expect(']');
+        return values;
+    }
+
+    template<typename Func>
+    void readObject(Func &&onMember)
+    {
+        expect('{');
+        if (consume('}'))
+        {
+            return;
+        }
+        do
+        {
+            std::string name = readString();
+            expect(':');
+            onMember(name, *this);
+        } while (consume(','));
+        expect('}');
+    }
+};
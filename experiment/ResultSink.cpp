@@ -0,0 +1,277 @@
+#include "ResultSink.hpp"
+#include "JsonLine.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+static const char *CSV_HEADER = "instance,algorithm,params,seed,cost,subset_count,wall_ms,evaluations,subsets";
+
+static std::string csvField(const std::string &text)
+{
+    if (text.find_first_of(",\"\n") == std::string::npos)
+    {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        quoted += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return quoted + '"';
+}
+
+static std::vector<std::string> splitCsvLine(const std::string &line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i)
+    {
+        char c = line[i];
+        if (quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+        {
+            fields.back() += '"';
+            i += 1;
+        }
+        else if (c == '"')
+        {
+            quoted = !quoted;
+        }
+        else if (c == ',' && !quoted)
+        {
+            fields.emplace_back();
+        }
+        else
+        {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+static ResultRecord parseJsonLine(const std::string &line)
+{
+    ResultRecord record;
+    JsonLineReader reader(line);
+    reader.readObject([&record](const std::string &name, JsonLineReader &value)
+    {
+        if (name == "instance") record.instance = value.readString();
+        else if (name == "algorithm") record.algorithm = value.readString();
+        else if (name == "params") record.params = value.readString();
+        else if (name == "seed") record.seed = static_cast<uint32_t>(std::stoul(value.readScalar()));
+        else if (name == "cost") record.cost = std::stoi(value.readScalar());
+        else if (name == "subset_count") record.subsetCount = std::stoul(value.readScalar());
+        else if (name == "wall_ms") record.wallMillis = std::stod(value.readScalar());
+        else if (name == "subsets") record.subsets = value.readIntArray();
+        else if (name == "evaluations")
+        {
+            std::string evaluations = value.readScalar();
+            if (evaluations != "null")
+            {
+                record.evaluations = std::stoull(evaluations);
+            }
+        }
+        else throw std::runtime_error("Unknown field '" + name + "' in result line");
+    });
+    return record;
+}
+
+static ResultRecord parseCsvLine(const std::string &line)
+{
+    std::vector<std::string> fields = splitCsvLine(line);
+    if (fields.size() != 9)
+    {
+        throw std::runtime_error("Expected 9 fields in result line: " + line);
+    }
+
+    ResultRecord record{
+        .instance = fields[0],
+        .algorithm = fields[1],
+        .params = fields[2],
+        .seed = static_cast<uint32_t>(std::stoul(fields[3])),
+        .cost = std::stoi(fields[4]),
+        .subsetCount = std::stoul(fields[5]),
+        .wallMillis = std::stod(fields[6]),
+        .evaluations = fields[7].empty() ? std::nullopt : std::optional<uint64_t>(std::stoull(fields[7])),
+        .subsets = {},
+        .improvements = {},
+    };
+    std::stringstream subsets(fields[8]);
+    for (int subset; subsets >> subset;)
+    {
+        record.subsets.push_back(subset);
+    }
+    return record;
+}
+
+/**
+ * @brief Cuts the file after its last complete line, dropping whatever a crash left half written.
+ *
+ * @return The size of the file afterwards.
+ */
+static std::uintmax_t dropPartialLine(const std::string &filepath)
+{
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(filepath, error);
+    if (error || size == 0)
+    {
+        return 0;
+    }
+
+    std::ifstream inputFile(filepath, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+    size_t lastNewline = contents.find_last_of('\n');
+    std::uintmax_t completeSize = lastNewline == std::string::npos ? 0 : lastNewline + 1;
+    if (completeSize != size)
+    {
+        inputFile.close();
+        std::filesystem::resize_file(filepath, completeSize);
+    }
+    return completeSize;
+}
+
+std::string ResultRecord::key() const
+{
+    return instance + ',' + algorithm + ',' + params + ',' + std::to_string(seed);
+}
+
+StreamingResultSink::StreamingResultSink(const std::string &filepath, size_t maxPendingRecords)
+    : m_Format(formatOf(filepath)), m_MaxPendingRecords(maxPendingRecords)
+{
+    bool empty = dropPartialLine(filepath) == 0;
+    m_Output.open(filepath, std::ios::app);
+    if (!m_Output.is_open())
+    {
+        throw std::runtime_error("Could not open result file " + filepath);
+    }
+    if (empty && m_Format == Format::Csv)
+    {
+        m_Output << CSV_HEADER << '\n' << std::flush;
+    }
+
+    m_Writer = std::thread(&StreamingResultSink::writerLoop, this);
+}
+
+StreamingResultSink::~StreamingResultSink()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_PendingChanged.notify_all();
+    m_Writer.join();
+}
+
+StreamingResultSink::Format StreamingResultSink::formatOf(const std::string &filepath)
+{
+    return std::filesystem::path(filepath).extension() == ".jsonl" ? Format::Jsonl : Format::Csv;
+}
+
+void StreamingResultSink::write(ResultRecord record)
+{
+    {
+        std::unique_lock lock(m_Mutex);
+        m_PendingChanged.wait(lock, [this] { return m_Pending.size() < m_MaxPendingRecords; });
+        m_Pending.push_back(std::move(record));
+    }
+    m_PendingChanged.notify_all();
+}
+
+void StreamingResultSink::flush()
+{
+    std::unique_lock lock(m_Mutex);
+    m_PendingChanged.wait(lock, [this] { return m_Pending.empty() && m_InProgress == 0; });
+}
+
+void StreamingResultSink::writerLoop()
+{
+    std::unique_lock lock(m_Mutex);
+    while (true)
+    {
+        m_PendingChanged.wait(lock, [this] { return m_Stopping || !m_Pending.empty(); });
+        if (m_Pending.empty())
+        {
+            return; // stopping, and everything has been written
+        }
+
+        std::deque<ResultRecord> records;
+        records.swap(m_Pending);
+        m_InProgress = records.size();
+        lock.unlock();
+        m_PendingChanged.notify_all(); // the queue has room again
+
+        for (const ResultRecord &record : records)
+        {
+            writeLine(record);
+        }
+        m_Output.flush();
+
+        lock.lock();
+        m_InProgress = 0;
+        m_PendingChanged.notify_all();
+    }
+}
+
+void StreamingResultSink::writeLine(const ResultRecord &record)
+{
+    if (m_Format == Format::Csv)
+    {
+        m_Output << csvField(record.instance) << ',' << csvField(record.algorithm) << ',' << csvField(record.params) << ','
+                 << record.seed << ',' << record.cost << ',' << record.subsetCount << ',' << record.wallMillis << ',';
+        if (record.evaluations)
+        {
+            m_Output << *record.evaluations;
+        }
+        m_Output << ',';
+        for (size_t i = 0; i < record.subsets.size(); ++i)
+        {
+            m_Output << (i ? " " : "") << record.subsets[i];
+        }
+    }
+    else
+    {
+        m_Output << "{\"instance\":";
+        writeJsonString(m_Output, record.instance);
+        m_Output << ",\"algorithm\":";
+        writeJsonString(m_Output, record.algorithm);
+        m_Output << ",\"params\":";
+        writeJsonString(m_Output, record.params);
+        m_Output << ",\"seed\":" << record.seed << ",\"cost\":" << record.cost << ",\"subset_count\":" << record.subsetCount
+                 << ",\"wall_ms\":" << record.wallMillis << ",\"evaluations\":";
+        if (record.evaluations)
+        {
+            m_Output << *record.evaluations;
+        }
+        else
+        {
+            m_Output << "null";
+        }
+        m_Output << ",\"subsets\":[";
+        for (size_t i = 0; i < record.subsets.size(); ++i)
+        {
+            m_Output << (i ? "," : "") << record.subsets[i];
+        }
+        m_Output << "]}";
+    }
+    m_Output << '\n';
+}
+
+std::vector<ResultRecord> StreamingResultSink::readRecords(const std::string &filepath)
+{
+    std::vector<ResultRecord> records;
+    std::ifstream inputFile(filepath);
+    Format format = formatOf(filepath);
+    for (std::string line; std::getline(inputFile, line);)
+    {
+        if (inputFile.eof())
+        {
+            break; // no trailing newline, the line was cut short
+        }
+        if (line.empty() || (format == Format::Csv && line == CSV_HEADER))
+        {
+            continue;
+        }
+        records.push_back(format == Format::Csv ? parseCsvLine(line) : parseJsonLine(line));
+    }
+    return records;
+}
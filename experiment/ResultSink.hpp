@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A point of a run where its best cost improved.
+ */
+struct CostImprovement
+{
+    double elapsedMillis = 0.0;
+    int bestCost = 0;
+};
+
+/**
+ * @brief The outcome of one experiment job.
+ */
+struct ResultRecord
+{
+    std::string instance;
+    std::string algorithm;
+    std::string params; // See AlgorithmConfig::paramsKey
+    uint32_t seed = 0;
+    int cost = 0;
+    size_t subsetCount = 0;
+    double wallMillis = 0.0;
+    std::optional<uint64_t> evaluations; // Only known when the library is built with HE_STATS
+    std::vector<int> subsets;
+    std::vector<CostImprovement> improvements; // Only recorded on request (see ExperimentRunner::setRecordImprovements), sinks do not store them
+
+    /**
+     * @brief Same as ExperimentJob::key, used to find the jobs that already have results.
+     */
+    std::string key() const;
+};
+
+/**
+ * @brief Destination of the results of an experiment.
+ */
+class ResultSink
+{
+public:
+    virtual ~ResultSink() = default;
+
+    /**
+     * @brief Stores a record. May be called from several threads at once.
+     */
+    virtual void write(ResultRecord record) = 0;
+
+    /**
+     * @brief Blocks until every record written so far is stored.
+     */
+    virtual void flush() = 0;
+};
+
+/**
+ * @brief Keeps every record in memory instead of storing it, for tools that analyze the runs they start.
+ */
+class CollectingSink : public ResultSink
+{
+private:
+    std::mutex m_Mutex;
+    std::vector<ResultRecord> m_Records;
+
+public:
+    void write(ResultRecord record) override
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Records.push_back(std::move(record));
+    }
+
+    void flush() override {}
+
+    std::vector<ResultRecord> takeRecords() { return std::move(m_Records); }
+};
+
+/**
+ * @brief Appends one line per record to a CSV or JSON Lines file. Records are queued and written by a background thread,
+ * which flushes the file after each group of lines it takes from the queue; at most maxPendingRecords records wait to be
+ * written, and past that, writers block until the file catches up.
+ * Lines are only ever appended, so a crash loses at most the records still queued. A line cut short by a crash is dropped
+ * when the file is opened again.
+ */
+class StreamingResultSink : public ResultSink
+{
+public:
+    enum class Format
+    {
+        Csv,
+        Jsonl
+    };
+
+private:
+    Format m_Format;
+    std::ofstream m_Output;
+    size_t m_MaxPendingRecords;
+
+    std::deque<ResultRecord> m_Pending;
+    size_t m_InProgress = 0; // Records taken by the writer but not yet flushed to the file
+    bool m_Stopping = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_PendingChanged;
+    std::thread m_Writer;
+
+    void writerLoop();
+    void writeLine(const ResultRecord &record);
+
+public:
+    /**
+     * @param filepath The file to append to. Files named *.jsonl are written as JSON Lines, any other as CSV.
+     */
+    explicit StreamingResultSink(const std::string &filepath, size_t maxPendingRecords = 256);
+    ~StreamingResultSink() override;
+
+    StreamingResultSink(const StreamingResultSink &) = delete;
+    StreamingResultSink &operator=(const StreamingResultSink &) = delete;
+
+    void write(ResultRecord record) override;
+    void flush() override;
+
+    static Format formatOf(const std::string &filepath);
+
+    /**
+     * @brief Reads back every complete record of a file written by a StreamingResultSink. A missing file has no records.
+     *
+     * @throws std::runtime_error If a line can not be parsed.
+     */
+    static std::vector<ResultRecord> readRecords(const std::string &filepath);
+};
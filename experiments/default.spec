@@ -0,0 +1,26 @@
+# BLGA runs on scpnrh5, as previously hard-coded in HeuroCli::evaluateFile
+assets = assets
+output = results.csv
+parallelism = 0
+time_budget_ms = 300000
+instances = scpnrh5
+repetitions = 2
+seed = 1
+
+[blga]
+populationSize = 300
+matesCount = 10
+geneCopyProbability = 0.8, 0.65
+rtsSampleSize = 50
+
+[blga]
+populationSize = 150
+matesCount = 10
+geneCopyProbability = 0.8
+rtsSampleSize = 50
+
+[blga]
+populationSize = 300
+matesCount = 5
+geneCopyProbability = 0.8, 0.65
+rtsSampleSize = 25
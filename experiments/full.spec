@@ -0,0 +1,54 @@
+# Every algorithm on every instance
+assets = assets
+output = results_full.csv
+parallelism = 0
+time_budget_ms = 300000
+instances = scp41, scp42, scpnrg1, scpnrg2, scpnrg3, scpnrg4, scpnrg5, scpnrh1, scpnrh2, scpnrh3, scpnrh4, scpnrh5
+repetitions = 3
+seed = 1
+
+[constructive]
+
+[grasp]
+maxSolCount = 100
+k = 5, 10
+
+[graspWithNoise]
+maxSolCount = 100
+k = 10
+rho = 5, 2
+
+[simulatedAnnealing]
+initTemp = 10.0
+iterPerTemp = 10, 50
+cooling = linear:0.1
+
+[simulatedAnnealing]
+initTemp = 5.0
+iterPerTemp = 10
+cooling = linear:0.01
+
+[simulatedAnnealing]
+initTemp = 10.0
+iterPerTemp = 10
+cooling = exp
+
+[vns]
+
+[blga]
+populationSize = 300
+matesCount = 10
+geneCopyProbability = 0.8, 0.65
+rtsSampleSize = 50
+
+[blga]
+populationSize = 150
+matesCount = 10
+geneCopyProbability = 0.8
+rtsSampleSize = 50
+
+[blga]
+populationSize = 300
+matesCount = 5
+geneCopyProbability = 0.8, 0.65
+rtsSampleSize = 25
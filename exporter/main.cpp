@@ -0,0 +1,53 @@
+#include "experiment/ResultSink.hpp"
+#include "io/ExcelFile.hpp"
+
+#include <iostream>
+#include <memory>
+
+/**
+ * Converts the results of an experiment into a workbook with one sheet per instance. Each row holds the cost, the
+ * amount of subsets and the subset IDs of a run, as heuro_cli used to write them.
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <results .csv/.jsonl> <output .xlsx>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::vector<ResultRecord> records = StreamingResultSink::readRecords(argv[1]);
+        if (records.empty())
+        {
+            std::cerr << "No results in " << argv[1] << std::endl;
+            return 1;
+        }
+
+        ExcelFile outputFile(argv[2], records.front().instance);
+        std::vector<int> values;
+        for (const ResultRecord &record : records)
+        {
+            if (!outputFile.hasSheet(record.instance))
+            {
+                outputFile.addSheet(record.instance);
+            }
+
+            values.clear();
+            values.push_back(record.cost);
+            values.push_back(static_cast<int>(record.subsetCount));
+            values.insert(values.end(), record.subsets.begin(), record.subsets.end());
+            outputFile.addValues(record.instance, values);
+        }
+
+        std::cout << "Exported " << records.size() << " results to " << argv[2] << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <util/ScpGenerator.hpp>
+
+#include <iostream>
+
+static const char *USAGE =
+    "Usage: heuro_generate [options] <output .txt>\n"
+    "  --style <beasley|rail>  Rows picking random columns, or columns covering consecutive rows (default: beasley)\n"
+    "  --rows <m>              Row count (default: 200)\n"
+    "  --columns <n>           Column count (default: 1000)\n"
+    "  --density <d>           Beasley: average fraction of the columns covering a row (default: 0.02)\n"
+    "  --max-column-rows <r>   Rail: most consecutive rows a column covers, at most 255 (default: 10)\n"
+    "  --costs <low>:<high>    Uniform cost range, low = high for unicost (default: 1:100 beasley, 1:3 rail)\n"
+    "  --min-coverage <c>      Columns covering every row at least (default: 2)\n"
+    "  --seed <s>              Seed of the instance (default: 1)\n";
+
+int main(int argc, char **argv)
+{
+    Heuro::ScpGeneratorOptions options;
+    std::string outputPath;
+    std::string costs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << arg << '\n' << USAGE;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--style")
+        {
+            std::string style = nextValue();
+            if (style != "beasley" && style != "rail")
+            {
+                std::cerr << "Unknown style '" << style << "'\n" << USAGE;
+                return 1;
+            }
+            options.style = style == "rail" ? Heuro::ScpGeneratorOptions::Style::Rail : Heuro::ScpGeneratorOptions::Style::Beasley;
+        }
+        else if (arg == "--rows") options.rowCount = std::stoi(nextValue());
+        else if (arg == "--columns") options.columnCount = std::stoi(nextValue());
+        else if (arg == "--density") options.density = std::stod(nextValue());
+        else if (arg == "--max-column-rows") options.maxColumnRows = std::stoi(nextValue());
+        else if (arg == "--costs") costs = nextValue();
+        else if (arg == "--min-coverage") options.minCoverage = std::stoi(nextValue());
+        else if (arg == "--seed") options.seed = std::stoull(nextValue());
+        else if (outputPath.empty() && arg.rfind("--", 0) != 0) outputPath = arg;
+        else
+        {
+            std::cerr << USAGE;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (outputPath.empty())
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    try
+    {
+        if (costs.empty())
+        {
+            costs = options.style == Heuro::ScpGeneratorOptions::Style::Rail ? "1:3" : "1:100";
+        }
+        size_t separator = costs.find(':');
+        options.minCost = std::stoi(costs.substr(0, separator));
+        options.maxCost = separator == std::string::npos ? options.minCost : std::stoi(costs.substr(separator + 1));
+
+        Heuro::ScpGenerator::writeFile(options, outputPath);
+        std::cout << "Wrote " << options.rowCount << "x" << options.columnCount << " instance to " << outputPath << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
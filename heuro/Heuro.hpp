@@ -1,9 +1,18 @@
 #pragma once
 
 #include "Scp.hpp"
+#include "ScpInstance.hpp"
 
 #include "util/Data.hpp"
+#include "util/EvaluationCache.hpp"
+#include "util/Executor.hpp"
+#include "util/IncumbentBoard.hpp"
 #include "util/RandomIntGenerator.hpp"
+#include "util/RandomSeed.hpp"
+#include "util/ScpGenerator.hpp"
 #include "util/ScpParser.hpp"
+#include "util/ScpSolutionFile.hpp"
 
-#include "debug/Instrumentor.hpp"
\ No newline at end of file
+#include "debug/ConvergenceTrace.hpp"
+#include "debug/Instrumentor.hpp"
+#include "debug/SearchStats.hpp"
\ No newline at end of file
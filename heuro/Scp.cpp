@@ -1,388 +1,1210 @@
 #include "Scp.hpp"
 
+#include "util/IncumbentBoard.hpp"
+#include "util/Lagrangian.hpp"
+#include "util/LocalSearch.hpp"
 #include "util/RandomIntGenerator.hpp"
 #include "util/RandomRealGenerator.hpp"
-#include "util/RandomBinaryGenerator.hpp"
+#include "util/RandomSeed.hpp"
+#include "util/ScpUtil.hpp"
 #include "util/Timer.hpp"
+#include "util/TournamentTree.hpp"
+#include "util/ZobristHash.hpp"
+
+#include "debug/ConvergenceTrace.hpp"
+#include "debug/Instrumentor.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <utility>
 #include <unordered_map>
 #include <queue>
+#include <stdexcept>
+#include <string>
 
 namespace Heuro
 {
-    namespace Util
+
+    template<typename Traits>
+    BasicScp<Traits>::BasicScp(std::shared_ptr<const Instance> instance, std::pmr::memory_resource *scratchUpstream)
+        : m_Instance(std::move(instance)),
+        m_Scratch((2 * m_Instance->subsetCount() + m_Instance->elementCount()) * sizeof(int), scratchUpstream)
     {
-        static std::vector<int> findMinIndices(const std::vector<int> &vec, int n)
-        {
-            std::vector<int> indices(vec.size());
-            std::iota(indices.begin(), indices.end(), 0);
+    }
 
-            std::partial_sort(indices.begin(), indices.begin() + n, indices.end(), [&vec](int i, int j) { return vec[i] < vec[j]; });
-            return std::vector<int>(indices.begin(), indices.begin() + n);
-        }
+    template<typename Traits>
+    BasicScp<Traits>::BasicScp(
+        int elementCount,
+        int subsetCount,
+        const std::vector<int> &costs,
+        const std::vector<std::unordered_set<int>> &relations,
+        std::pmr::memory_resource *scratchUpstream)
+        : BasicScp(std::make_shared<Instance>(elementCount, subsetCount, costs, relations), scratchUpstream)
+    {
+    }
+
+    template<typename Traits>
+    std::string BasicScp<Traits>::representation() const
+    {
+        return Traits::name();
+    }
+
+    template<typename Traits>
+    std::shared_ptr<const ScpInstance> BasicScp<Traits>::instance() const
+    {
+        return m_Instance;
+    }
 
-        static auto findMinSubsetCost(const std::vector<std::pair<std::unordered_set<int>, int>> &subsets)
+    template<typename Traits>
+    const MemoryStats &BasicScp<Traits>::scratchMemoryStats() const
+    {
+        return m_Scratch.stats();
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::resetScratchMemoryStats()
+    {
+        m_Scratch.resetStats();
+    }
+
+    template<typename Traits>
+    const SearchStats &BasicScp<Traits>::lastRunStats() const
+    {
+        return m_Stats;
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::setConvergenceTrace(ConvergenceTrace *trace)
+    {
+        m_Trace = trace;
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::setEvaluationCache(std::shared_ptr<EvaluationCache> cache)
+    {
+        m_EvaluationCache = std::move(cache);
+    }
+
+    template<typename Traits>
+    const std::shared_ptr<EvaluationCache> &BasicScp<Traits>::evaluationCache() const
+    {
+        return m_EvaluationCache;
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::setExecutor(Executor *executor)
+    {
+        m_Executor = executor;
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::setInitialSolutions(const std::vector<ScpResult> &solutions)
+    {
+        std::vector<std::vector<Index>> initialSolutions;
+        initialSolutions.reserve(solutions.size());
+        for (const ScpResult &solution : solutions)
         {
-            return std::min_element(
-                subsets.begin(),
-                subsets.end(),
-                [](const auto &a, const auto &b)
+            std::vector<Index> &subsets = initialSolutions.emplace_back();
+            for (int subset : solution.subsetIDs)
+            {
+                if (subset < 0 || subset >= m_Instance->subsetCount())
                 {
-                    return a.second < b.second;
+                    throw std::invalid_argument("Initial solution selects subset " + std::to_string(subset) + ", out of the instance");
                 }
-            );
+                subsets.push_back(static_cast<Index>(subset));
+            }
+            std::sort(subsets.begin(), subsets.end());
         }
+        m_InitialSolutions = std::move(initialSolutions);
+    }
 
-        template<size_t size>
-        static std::bitset<size> genRandomBitset(double probability)
-        {
-            std::bitset<size> bits;
-            RandomBinaryGenerator gen(probability);
+    template<typename Traits>
+    void BasicScp<Traits>::setIncumbentBoard(IncumbentBoard *board)
+    {
+        m_Board = board;
+    }
 
-            for (int i = 0; i < size; ++i)
-            {
-                bits[i] = gen();
-            }
+    template<typename Traits>
+    void BasicScp<Traits>::setCheckpoint(const std::string &path, long intervalMillis)
+    {
+        m_Checkpoints = path.empty() ? nullptr : std::make_unique<CheckpointWriter>(path, intervalMillis);
+    }
 
-            return bits;
+    template<typename Traits>
+    typename BasicScp<Traits>::ScpSolution BasicScp<Traits>::toCompleteSolution(const std::vector<Index> &subsets)
+    {
+        ScpSolution solution(m_Instance->elementCount(), m_Instance->subsetCount());
+        for (Index subset : subsets)
+        {
+            solution.add(subset, m_Instance->costs()[subset], m_Instance->subsetElements()[subset]);
         }
 
-        template<size_t size>
-        static void truncateBitsetAfterIndex(std::bitset<size> &bits, size_t startIndex)
+        // cover what is left with the cheapest subset of each uncovered element
+        for (int element = 0; element < m_Instance->elementCount() && !solution.isFeasible(); ++element)
         {
-            for (size_t i = startIndex; i < size; ++i)
+            if (solution.coverage(element) == 0 && !m_Instance->relations()[element].empty())
             {
-                bits.reset(i);
+                Index cheapest = *std::min_element(m_Instance->relations()[element].begin(), m_Instance->relations()[element].end(),
+                    [this](Index a, Index b) { return m_Instance->costs()[a] < m_Instance->costs()[b]; });
+                solution.add(cheapest, m_Instance->costs()[cheapest], m_Instance->subsetElements()[cheapest]);
             }
         }
+        return solution;
+    }
 
-        template<size_t size>
-        static std::bitset<size> setToBitset(const std::unordered_set<int> &set)
+    template<typename Traits>
+    std::optional<typename BasicScp<Traits>::ScpSolution> BasicScp<Traits>::bestInitialSolution()
+    {
+        std::optional<ScpSolution> bestSolution;
+        for (const std::vector<Index> &subsets : m_InitialSolutions)
         {
-            std::bitset<size> bits;
-            for (int value : set)
+            ScpSolution solution = toCompleteSolution(subsets);
+            if (!bestSolution || solution.cost() < bestSolution->cost())
             {
-                bits.set(value);
+                bestSolution = std::move(solution);
             }
+        }
+        return bestSolution;
+    }
+
+    template<typename Traits>
+    typename BasicScp<Traits>::ScpSolution BasicScp<Traits>::startingSolution()
+    {
+        std::optional<ScpSolution> initialSolution = bestInitialSolution();
+        return initialSolution ? std::move(*initialSolution) : graspInternal(1, 1);
+    }
 
-            return bits;
+    template<typename Traits>
+    void BasicScp<Traits>::keepBestInitialSolution(ScpSolution &solution)
+    {
+        std::optional<ScpSolution> initialSolution = bestInitialSolution();
+        if (initialSolution && initialSolution->cost() < solution.cost())
+        {
+            solution = std::move(*initialSolution);
         }
+    }
 
-        template<size_t size>
-        static std::unordered_set<int> bitsetToSet(const std::bitset<size> &bits)
+    template<typename Traits>
+    bool BasicScp<Traits>::beatsBoard(int cost) const
+    {
+        return m_Board && cost < m_Board->bestCost();
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::publishToBoard(const ScpSolution &solution)
+    {
+        if (beatsBoard(solution.cost()))
         {
-            std::unordered_set<int> set;
-            for (int i = 0; i < bits.size(); ++i)
-            {
-                if (bits[i])
-                {
-                    set.insert(i);
-                }
-            }
+            m_Board->publish(solution.toResult());
+        }
+    }
 
-            return set;
+    template<typename Traits>
+    std::optional<typename BasicScp<Traits>::ScpSolution> BasicScp<Traits>::boardSolutionBelow(int cost)
+    {
+        if (!m_Board || m_Board->bestCost() >= cost)
+        {
+            return std::nullopt;
         }
+        std::optional<ScpResult> boardResult = m_Board->read();
+        if (!boardResult)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<Index> subsets(boardResult->subsetIDs.begin(), boardResult->subsetIDs.end());
+        std::sort(subsets.begin(), subsets.end());
+        ScpSolution solution = toCompleteSolution(subsets);
+        if (solution.cost() >= cost)
+        {
+            return std::nullopt;
+        }
+        return solution;
     }
 
-    Scp::Scp(int elementCount, int subsetCount, std::vector<int> costs, std::vector<std::unordered_set<int>> relations)
-        : m_ElementCount(elementCount), m_SubsetCount(subsetCount), m_Costs(std::move(costs)), m_Relations(std::move(relations))
+    template<typename Traits>
+    bool BasicScp<Traits>::exchangeWithBoard(ScpSolution &solution, int bestCost)
     {
+        if (!m_Board)
+        {
+            return false;
+        }
+        if (beatsBoard(solution.cost()))
+        {
+            m_Board->publish(solution.toResult());
+            return false;
+        }
+        std::optional<ScpSolution> boardSolution = boardSolutionBelow(bestCost);
+        if (!boardSolution)
+        {
+            return false;
+        }
+        solution = std::move(*boardSolution);
+        return true;
     }
 
-    ScpResult Scp::constructive()
+    template<typename Index>
+    static std::vector<int> sortedSubsets(const std::vector<Index> &subsets)
     {
-        return graspInternal(1, 1);
+        std::vector<int> sorted(subsets.begin(), subsets.end());
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
     }
 
-    ScpResult Scp::grasp(int maxSolCount, int k)
+    template<typename Traits>
+    std::optional<SearchCheckpoint> BasicScp<Traits>::beginCheckpointedRun(const std::string &algorithm, const std::string &parameters)
     {
-        return graspInternal(maxSolCount, k);
+        if (!m_Checkpoints)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<SearchCheckpoint> checkpoint = m_Checkpoints->begin();
+        bool isSameRun = !checkpoint
+            || (checkpoint->algorithm == algorithm && checkpoint->parameters == parameters
+                && checkpoint->elementCount == m_Instance->elementCount() && checkpoint->subsetCount == m_Instance->subsetCount());
+        if (!isSameRun)
+        {
+            throw std::runtime_error("Checkpoint " + m_Checkpoints->path() + " holds another run: " + checkpoint->algorithm + " (" + checkpoint->parameters + ")");
+        }
+        if (checkpoint && checkpoint->solutions.empty())
+        {
+            throw std::runtime_error("Checkpoint " + m_Checkpoints->path() + " holds no solution");
+        }
+        return checkpoint;
     }
 
-    ScpResult Scp::graspWithNoise(int maxSolCount, int k, int rho)
+    template<typename Traits>
+    SearchCheckpoint BasicScp<Traits>::newCheckpoint(const std::string &algorithm, const std::string &parameters, long elapsedMillis) const
     {
-        return graspInternal(maxSolCount, k, rho);
+        SearchCheckpoint checkpoint;
+        checkpoint.algorithm = algorithm;
+        checkpoint.parameters = parameters;
+        checkpoint.elementCount = m_Instance->elementCount();
+        checkpoint.subsetCount = m_Instance->subsetCount();
+        checkpoint.elapsedMillis = elapsedMillis;
+        checkpoint.threadRandomState = RandomSeed::saveState();
+        return checkpoint;
     }
 
-    ScpResult Scp::simulatedAnnealing(long maxRuntime, double initTemp, int iterPerTemp, const std::function<double(double, int)> &tempCoolingSchedule)
+    template<typename Traits>
+    void BasicScp<Traits>::finishCheckpointedRun()
     {
-        ScpResult currentSolution = constructive();
-        RandomRealGenerator randGen(0.0, 1.0);
+        if (m_Checkpoints)
+        {
+            m_Checkpoints->finish();
+        }
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::removeRedundantSubsets(ScpSolution &solution)
+    {
+        m_CandidatesScratch.assign(solution.subsets().begin(), solution.subsets().end());
+        std::stable_sort(m_CandidatesScratch.begin(), m_CandidatesScratch.end(), [this](Index a, Index b) { return m_Instance->costs()[a] > m_Instance->costs()[b]; });
+        for (Index subset : m_CandidatesScratch)
+        {
+            const std::vector<Index> &elements = m_Instance->subsetElements()[subset];
+            bool isRedundant = std::all_of(elements.begin(), elements.end(), [&solution](Index element) { return solution.coverage(element) > 1; });
+            if (isRedundant)
+            {
+                solution.remove(subset, m_Instance->costs()[subset], elements);
+            }
+        }
+    }
+
+    template<typename Traits>
+    bool BasicScp<Traits>::applyEdits(const ScpEdits &edits)
+    {
+        edits.validate(m_Instance->elementCount(), m_Instance->subsetCount());
+
+        int elementCount = m_Instance->elementCount() + static_cast<int>(edits.addedRows.size());
+        int subsetCount = m_Instance->subsetCount() + static_cast<int>(edits.addedColumns.size());
+        using Costs = CostTable<typename Traits::Cost>;
+        bool fitsCosts = std::all_of(edits.addedColumns.begin(), edits.addedColumns.end(), [](const ScpColumn &column) { return Costs::fits(column.cost); })
+            && std::all_of(edits.costChanges.begin(), edits.costChanges.end(), [](const auto &change) { return Costs::fits(change.second); });
+        if (!Traits::fitsSize(elementCount, subsetCount) || !fitsCosts)
+        {
+            return false;
+        }
+        if (m_Instance->leavesUncoverable(edits))
+        {
+            throw std::invalid_argument("Instance edits leave an element in no subset");
+        }
 
-        int iterCount = 0;
-        double currentTemp = initTemp;
-        Timer timer(maxRuntime);
-        while (!timer.hasStopped() && currentTemp > 0.0)
+        // the other solvers holding the instance keep reading it as it was, so the edits go to a copy of it unless this
+        // solver holds the only reference
+        std::shared_ptr<Instance> edited = m_Instance.use_count() == 1
+            ? std::const_pointer_cast<Instance>(m_Instance)
+            : std::make_shared<Instance>(*m_Instance);
+        edited->applyEdits(edits);
+        m_Instance = std::move(edited);
+        m_EvaluationCache.reset();
+        m_Board = nullptr;
+        return true;
+    }
+
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::reoptimize(const ScpResult &previousSolution, long maxRuntime)
+    {
+        m_Stats = {};
+        std::vector<Index> subsets;
+        for (int subset : previousSolution.subsetIDs)
         {
-            for (int i = 0; i < iterPerTemp; ++i)
+            if (subset >= 0 && subset < m_Instance->subsetCount() && !m_Instance->subsetElements()[subset].empty())
             {
-                ScpResult neighbourSolution = generateNeighbour(currentSolution, 0);
+                subsets.push_back(static_cast<Index>(subset));
+            }
+        }
+
+        ScpSolution solution = toCompleteSolution(subsets);
+        removeRedundantSubsets(solution);
+        return vnsInternal(std::move(solution), maxRuntime, "reoptimize").toResult();
+    }
+
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::constructive()
+    {
+        m_Stats = {};
+        ScpSolution solution = graspInternal(1, 1);
+        keepBestInitialSolution(solution);
+        publishToBoard(solution);
+        return solution.toResult();
+    }
+
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::grasp(int maxSolCount, int k)
+    {
+        m_Stats = {};
+        ScpSolution solution = graspInternal(maxSolCount, k);
+        keepBestInitialSolution(solution);
+        publishToBoard(solution);
+        return solution.toResult();
+    }
+
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::graspWithNoise(int maxSolCount, int k, int rho)
+    {
+        m_Stats = {};
+        ScpSolution solution = graspInternal(maxSolCount, k, rho);
+        keepBestInitialSolution(solution);
+        publishToBoard(solution);
+        return solution.toResult();
+    }
 
-                int deltaCost = neighbourSolution.cost - currentSolution.cost;
-                if (deltaCost <= 0)
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::simulatedAnnealing(long maxRuntime, double initTemp, int iterPerTemp, const std::function<double(double, int)> &tempCoolingSchedule)
+    {
+        m_Stats = {};
+        const std::string parameters = "initTemp=" + std::to_string(initTemp) + ";iterPerTemp=" + std::to_string(iterPerTemp);
+        std::optional<SearchCheckpoint> resumed = beginCheckpointedRun("simulatedAnnealing", parameters);
+        ScpSolution currentSolution = resumed ? toCompleteSolution(std::vector<Index>(resumed->solutions.at(0).begin(), resumed->solutions.at(0).end())) : startingSolution();
+
+        using Moves = NeighbourhoodSequence<BasicScp, ScpSolution, &BasicScp::randomNeighbour>;
+        LocalSearch<ScpSolution, Moves, MetropolisAcceptance, FunctionCooling, Timer> search(Moves(*this), {}, { tempCoolingSchedule, initTemp },
+            Timer(maxRuntime, resumed ? resumed->elapsedMillis : 0), iterPerTemp, m_Stats);
+        if (resumed)
+        {
+            search.resume(resumed->iteration, resumed->moveCount, resumed->bestCost);
+            search.cooling().restore(resumed->temperature);
+            search.acceptance().restoreState(resumed->generatorRandomState);
+            RandomSeed::restoreState(resumed->threadRandomState);
+        }
+
+        search.run(
+            currentSolution,
+            [&](const ScpSolution &solution)
+            {
+                if (m_Checkpoints && m_Checkpoints->isDue())
                 {
-                    currentSolution = std::move(neighbourSolution);
+                    SearchCheckpoint checkpoint = newCheckpoint("simulatedAnnealing", parameters, search.stop().elapsedMillis());
+                    checkpoint.iteration = search.step();
+                    checkpoint.moveCount = search.moveCount();
+                    checkpoint.temperature = search.cooling().temperature();
+                    checkpoint.bestCost = search.bestCost();
+                    checkpoint.generatorRandomState = search.acceptance().saveState();
+                    checkpoint.solutions.push_back(sortedSubsets(solution.subsets()));
+                    m_Checkpoints->save(std::move(checkpoint));
                 }
-                else
+            },
+            [&](const ScpSolution &solution)
+            {
+                if (m_Trace)
                 {
-                    double acceptanceProbability = exp(-deltaCost / currentTemp);
-                    if (randGen() <= acceptanceProbability)
-                    {
-                        currentSolution = std::move(neighbourSolution);
-                    }
+                    m_Trace->record(search.moveCount(), solution.cost(), search.bestCost());
                 }
-            }
+            },
+            [&](ScpSolution &solution)
+            {
+                // the board is checked once per temperature, and only replaces the current solution if it beats the best of the run
+                exchangeWithBoard(solution, search.bestCost());
+            });
 
-            iterCount += 1;
-            timer.tick();
-            currentTemp = tempCoolingSchedule(initTemp, iterCount);
-        }
+        finishCheckpointedRun();
+        return currentSolution.toResult();
+    }
 
-        return currentSolution;
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::vns(long maxRuntime)
+    {
+        m_Stats = {};
+        return vnsInternal(startingSolution(), maxRuntime, "vns").toResult();
     }
 
-    ScpResult Scp::vns(long maxRuntime)
+    template<typename Traits>
+    typename BasicScp<Traits>::ScpSolution BasicScp<Traits>::vnsInternal(ScpSolution currentSolution, long maxRuntime, const std::string &algorithm)
     {
-        ScpResult currentSolution = constructive();
+        std::optional<SearchCheckpoint> resumed = beginCheckpointedRun(algorithm, "");
+        if (resumed)
+        {
+            currentSolution = toCompleteSolution(std::vector<Index>(resumed->solutions.at(0).begin(), resumed->solutions.at(0).end()));
+            RandomSeed::restoreState(resumed->threadRandomState);
+        }
 
-        Timer timer(maxRuntime);
-        while (!timer.hasStopped())
+        // one move per round, through the neighbourhoods from the smallest to the largest until one does not worsen the solution
+        using Moves = NeighbourhoodSequence<BasicScp, ScpSolution, &BasicScp::randomNeighbour, &BasicScp::sequentialRemovalNeighbour,
+            &BasicScp::bestNeighbour, &BasicScp::flipNeighbour>;
+        LocalSearch<ScpSolution, Moves, NonWorseningAcceptance, NoCooling, Timer> search(Moves(*this), {}, {},
+            Timer(maxRuntime, resumed ? resumed->elapsedMillis : 0), 1, m_Stats);
+        if (resumed)
         {
-            for (int k = 0; k < 3; ++k)
+            search.resume(resumed->iteration, resumed->iteration, currentSolution.cost());
+        }
+
+        search.run(
+            currentSolution,
+            [&](const ScpSolution &solution)
             {
-                ScpResult neighbourSolution = generateNeighbour(currentSolution, k);
-                int deltaCost = neighbourSolution.cost - currentSolution.cost;
-                if (deltaCost <= 0)
+                if (m_Checkpoints && m_Checkpoints->isDue())
                 {
-                    currentSolution = std::move(neighbourSolution);
-                    break;
+                    SearchCheckpoint checkpoint = newCheckpoint(algorithm, "", search.stop().elapsedMillis());
+                    checkpoint.iteration = search.step();
+                    checkpoint.solutions.push_back(sortedSubsets(solution.subsets()));
+                    m_Checkpoints->save(std::move(checkpoint));
                 }
-            }
-
-            timer.tick();
-        }
+            },
+            [](const ScpSolution &) {},
+            [&](ScpSolution &solution)
+            {
+                // the current solution never gets worse, so it is also the best one
+                exchangeWithBoard(solution, solution.cost());
+                if (m_Trace)
+                {
+                    m_Trace->record(search.step(), solution.cost(), solution.cost());
+                }
+            });
 
+        finishCheckpointedRun();
         return currentSolution;
     }
 
-    ScpResult Scp::blga(long maxRuntime, int populationSize, int matesCount, double geneCopyProbability, int rtsSampleSize)
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::blga(long maxRuntime, int populationSize, int matesCount, double geneCopyProbability, int rtsSampleSize)
     {
-        constexpr size_t BITSET_SIZE = 1024;
+        m_Stats = {};
+        if (!m_EvaluationCache)
+        {
+            m_EvaluationCache = std::make_shared<EvaluationCache>();
+        }
 
-        ScpResult initialSolution = constructive();
-        auto leaderChromosome = Util::setToBitset<BITSET_SIZE>(initialSolution.subsetIDs);
-        int leaderChromosomeCost = initialSolution.cost;
+        const std::string parameters = "populationSize=" + std::to_string(populationSize) + ";matesCount=" + std::to_string(matesCount)
+            + ";geneCopyProbability=" + std::to_string(geneCopyProbability) + ";rtsSampleSize=" + std::to_string(rtsSampleSize);
+        std::optional<SearchCheckpoint> resumed = beginCheckpointedRun("blga", parameters);
 
-        std::vector<std::bitset<BITSET_SIZE>> population;
+        // the initial solutions join the population as they are, the rest of it is random
+        BlgaIndividual leader;
+        std::vector<BlgaIndividual> population;
+        std::unordered_map<uint64_t, int> populationHashes;
         population.reserve(populationSize);
-        for (int i = 0; i < populationSize; ++i)
+        if (resumed)
+        {
+            leader.genes = Util::vecToBitset(resumed->solutions.at(0), m_Instance->subsetCount());
+            for (size_t i = 1; i < resumed->solutions.size(); ++i)
+            {
+                population.push_back({ Util::vecToBitset(resumed->solutions[i], m_Instance->subsetCount()) });
+            }
+        }
+        else
+        {
+            leader.genes = Util::vecToBitset(startingSolution().subsets(), m_Instance->subsetCount());
+            for (int i = 0; i < populationSize; ++i)
+            {
+                population.push_back({ i < static_cast<int>(m_InitialSolutions.size())
+                    ? Util::vecToBitset(toCompleteSolution(m_InitialSolutions[i]).subsets(), m_Instance->subsetCount())
+                    : Util::genRandomBitset(m_Instance->subsetCount(), 0.5) });
+            }
+        }
+        evaluateIndividual(leader);
+        for (BlgaIndividual &individual : population)
         {
-            auto bits = Util::genRandomBitset<BITSET_SIZE>(0.5);
-            Util::truncateBitsetAfterIndex(bits, m_SubsetCount);
-            population.push_back(bits);
+            evaluateIndividual(individual);
+            populationHashes[individual.hash] += 1;
         }
 
-        Timer timer(maxRuntime);
+        BlgaIndividual offspring{ Bitset(m_Instance->subsetCount()) };
+        long generationCount = 0;
+        if (resumed)
+        {
+            generationCount = resumed->iteration;
+            RandomSeed::restoreState(resumed->threadRandomState);
+        }
+        Timer timer(maxRuntime, resumed ? resumed->elapsedMillis : 0);
         while (!timer.hasStopped())
         {
-            std::vector<int> mates = positiveAssortativeMating<BITSET_SIZE>(leaderChromosome, population, matesCount);
-            std::bitset<BITSET_SIZE> offspring;
-            std::unordered_set<int> offspringAsSet;
-            do
+            if (m_Checkpoints && m_Checkpoints->isDue())
+            {
+                SearchCheckpoint checkpoint = newCheckpoint("blga", parameters, timer.elapsedMillis());
+                checkpoint.iteration = generationCount;
+                checkpoint.solutions.reserve(population.size() + 1);
+                checkpoint.solutions.push_back(Util::bitsetToVec(leader.genes));
+                for (const BlgaIndividual &individual : population)
+                {
+                    checkpoint.solutions.push_back(Util::bitsetToVec(individual.genes));
+                }
+                m_Checkpoints->save(std::move(checkpoint));
+            }
+
             {
-                offspring = randomParentUniformCrossover<BITSET_SIZE>(leaderChromosome, population, mates, geneCopyProbability, m_SubsetCount);
-                offspringAsSet = Util::bitsetToSet<BITSET_SIZE>(offspring);
-            } while (!isSolutionFeasible(offspringAsSet));
+                std::pmr::vector<int> mates = positiveAssortativeMating(leader.genes, population, matesCount);
+                randomParentUniformCrossover(leader, population, mates, geneCopyProbability, offspring);
+                evaluateIndividualCached(offspring);
+                while (!offspring.feasible)
+                {
+                    HE_STATS_INCREMENT(m_Stats.repairCalls);
+                    randomParentUniformCrossover(leader, population, mates, geneCopyProbability, offspring);
+                    evaluateIndividualCached(offspring);
+                }
+            }
 
-            int offspringCost = calculateSolutionCost(offspringAsSet);
-            if (offspringCost < leaderChromosomeCost)
+            HE_STATS_INCREMENT(m_Stats.movesProposed);
+            int offspringCost = offspring.cost; // Traced below, once an improving offspring has been swapped with the leader
+            if (offspring.cost < leader.cost)
             {
-                restrictedTournamentSelection<BITSET_SIZE>(population, leaderChromosome, rtsSampleSize);
-                leaderChromosome = offspring;
-                leaderChromosomeCost = offspringCost;
+                restrictedTournamentSelection(population, populationHashes, leader, rtsSampleSize);
+                std::swap(leader, offspring);
+                HE_STATS_INCREMENT(m_Stats.movesAccepted);
+                HE_STATS_INCREMENT(m_Stats.movesImproving);
+            }
+            else if (offspring.hash == leader.hash)
+            {
+                HE_STATS_INCREMENT(m_Stats.duplicatesRejected);
             }
             else
             {
-                restrictedTournamentSelection<BITSET_SIZE>(population, offspring, rtsSampleSize);
+                restrictedTournamentSelection(population, populationHashes, offspring, rtsSampleSize);
             }
 
+            // a cheaper solution on the board takes over as leader, and the old leader competes for a place in the population
+            if (beatsBoard(leader.cost))
+            {
+                auto leaderAsSet = Util::bitsetToSet(leader.genes);
+                m_Board->publish({ leader.cost, leaderAsSet.size(), std::move(leaderAsSet) });
+            }
+            else if (std::optional<ScpSolution> boardSolution = boardSolutionBelow(leader.cost))
+            {
+                BlgaIndividual boardLeader{ Util::vecToBitset(boardSolution->subsets(), m_Instance->subsetCount()) };
+                evaluateIndividual(boardLeader);
+                restrictedTournamentSelection(population, populationHashes, leader, rtsSampleSize);
+                std::swap(leader, boardLeader);
+            }
+
+            if (m_Trace)
+            {
+                m_Trace->record(generationCount, offspringCost, leader.cost);
+            }
+            generationCount += 1;
+            HE_STATS_INCREMENT(m_Stats.generations);
+            m_Scratch.reset();
             timer.tick();
         }
 
-        auto leaderAsSet = Util::bitsetToSet<BITSET_SIZE>(leaderChromosome);
-        return { leaderChromosomeCost, leaderAsSet.size(), std::move(leaderAsSet) };
+        finishCheckpointedRun();
+        auto leaderAsSet = Util::bitsetToSet(leader.genes);
+        return { leader.cost, leaderAsSet.size(), std::move(leaderAsSet) };
+    }
+
+    template<typename Traits>
+    ScpResult BasicScp<Traits>::coreProblem(long maxRuntime, int columnsPerRow, int pricingRounds, const std::function<ScpResult(ScpSolver &core, long roundRuntime)> &algorithm)
+    {
+        constexpr int SUBGRADIENT_ITERATIONS = 1000; // Per round, on the core
+
+        m_Stats = {};
+        auto start = std::chrono::steady_clock::now();
+        columnsPerRow = std::max(columnsPerRow, 1);
+        pricingRounds = std::max(pricingRounds, 1);
+
+        LagrangianRelaxation<Traits> relaxation(m_Instance->elementCount(), m_Instance->costs(), m_Instance->subsetElements());
+        std::vector<double> multipliers = relaxation.initialMultipliers();
+        std::vector<double> reducedCosts;
+        std::vector<int> coreIndexes(m_Instance->subsetCount(), -1); // Index of each subset within the core, or -1 if left out
+        std::vector<int> coreSubsets; // Subset of this instance behind each core column
+        std::vector<int> rowCandidates;
+        ScpResult bestResult;
+        bool hasBestResult = false;
+        if (std::optional<ScpSolution> initialSolution = bestInitialSolution())
+        {
+            bestResult = initialSolution->toResult();
+            hasBestResult = true;
+        }
+
+        for (int round = 0; round < pricingRounds; ++round)
+        {
+            if (std::optional<ScpSolution> boardSolution = boardSolutionBelow(hasBestResult ? bestResult.cost : std::numeric_limits<int>::max()))
+            {
+                bestResult = boardSolution->toResult();
+                hasBestResult = true;
+            }
+
+            {
+                HE_PROFILE_SCOPE("Scp::coreProblem pricing");
+                relaxation.reducedCosts(multipliers, reducedCosts);
+
+                for (int subset : coreSubsets)
+                {
+                    coreIndexes[subset] = -1;
+                }
+                coreSubsets.clear();
+                auto addToCore = [&coreIndexes, &coreSubsets](int subset)
+                {
+                    if (coreIndexes[subset] < 0)
+                    {
+                        coreIndexes[subset] = static_cast<int>(coreSubsets.size());
+                        coreSubsets.push_back(subset);
+                    }
+                };
+
+                for (int subset : bestResult.subsetIDs)
+                {
+                    addToCore(subset);
+                }
+                for (int element = 0; element < m_Instance->elementCount(); ++element)
+                {
+                    rowCandidates.assign(m_Instance->relations()[element].begin(), m_Instance->relations()[element].end());
+                    auto kept = rowCandidates.begin() + std::min<size_t>(columnsPerRow, rowCandidates.size());
+                    std::nth_element(rowCandidates.begin(), kept, rowCandidates.end(),
+                        [&reducedCosts](int i, int j) { return reducedCosts[i] < reducedCosts[j]; });
+                    std::for_each(rowCandidates.begin(), kept, addToCore);
+                }
+            }
+
+            int coreSize = static_cast<int>(coreSubsets.size());
+            ScpInput coreInput{ m_Instance->elementCount(), coreSize, std::vector<int>(coreSize), std::vector<std::unordered_set<int>>(m_Instance->elementCount()) };
+            std::vector<std::vector<Index>> coreSubsetElements(coreSize);
+            for (int i = 0; i < coreSize; ++i)
+            {
+                coreInput.costs[i] = m_Instance->costs()[coreSubsets[i]];
+                coreSubsetElements[i] = m_Instance->subsetElements()[coreSubsets[i]];
+                for (Index element : coreSubsetElements[i])
+                {
+                    coreInput.relations[element].insert(i);
+                }
+            }
+            CostTable<typename Traits::Cost> coreCosts(coreInput.costs);
+
+            // the core may fit a narrower representation than the whole instance
+            std::unique_ptr<ScpSolver> core = ScpSolver::create(coreInput);
+            core->setConvergenceTrace(m_Trace);
+            core->setExecutor(m_Executor);
+            if (hasBestResult)
+            {
+                // every round continues from the best solution so far, whose columns are all in the core
+                ScpResult coreBest{ bestResult.cost, bestResult.subsetCount };
+                for (int subset : bestResult.subsetIDs)
+                {
+                    coreBest.subsetIDs.insert(coreIndexes[subset]);
+                }
+                core->setInitialSolutions({ coreBest });
+            }
+
+            long elapsedMillis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            long roundRuntime = std::max(0L, (maxRuntime - elapsedMillis) / (pricingRounds - round));
+            ScpResult coreResult = algorithm(*core, roundRuntime);
+            m_Stats += core->lastRunStats();
+
+            if (!hasBestResult || coreResult.cost < bestResult.cost)
+            {
+                hasBestResult = true;
+                bestResult.cost = coreResult.cost;
+                bestResult.subsetCount = coreResult.subsetCount;
+                bestResult.subsetIDs.clear();
+                for (int coreSubset : coreResult.subsetIDs)
+                {
+                    bestResult.subsetIDs.insert(coreSubsets[coreSubset]);
+                }
+            }
+            if (beatsBoard(bestResult.cost))
+            {
+                m_Board->publish(bestResult);
+            }
+
+            // better multipliers on the core give better prices for the whole column set in the next round
+            if (round + 1 < pricingRounds)
+            {
+                HE_PROFILE_SCOPE("Scp::coreProblem subgradient");
+                LagrangianRelaxation<Traits> coreRelaxation(m_Instance->elementCount(), coreCosts, coreSubsetElements);
+                multipliers = coreRelaxation.optimize(bestResult.cost, std::move(multipliers), SUBGRADIENT_ITERATIONS).multipliers;
+            }
+        }
+
+        return bestResult;
     }
 
-    ScpResult Scp::graspInternal(int maxSolCount, int k, int rho)
+    template<typename Traits>
+    typename BasicScp<Traits>::ScpSolution BasicScp<Traits>::graspInternal(int maxSolCount, int k, int rho)
     {
-        std::vector<std::pair<std::unordered_set<int>, int>> foundSolutions; // list of solutions and costs
-        foundSolutions.reserve(maxSolCount);
+        // every construction draws its randomness from its own seed, so the result does not depend on the thread that builds it
+        std::vector<uint64_t> seeds(std::max(maxSolCount, 0));
+        for (uint64_t &seed : seeds)
+        {
+            seed = RandomSeed::next();
+        }
+        std::vector<int> costs(seeds.size());
 
-        for (int i = 0; i < maxSolCount; ++i)
+        // the best solution among the constructions in [begin, end), the earliest one on ties
+        auto constructRange = [this, k, rho, &seeds, &costs](size_t begin, size_t end, ScratchArena &scratch)
         {
-            auto solution = greedyRandomized(k, rho);
-            int solutionCost = calculateSolutionCost(solution);
+            std::optional<ScpSolution> bestSolution;
+            ScpSolution solution(m_Instance->elementCount(), m_Instance->subsetCount());
+            for (size_t i = begin; i < end; ++i)
+            {
+                {
+                    RandomSeed::Scope seed(seeds[i]);
+                    greedyRandomized(solution, k, rho, scratch);
+                }
+                scratch.reset();
+                costs[i] = solution.cost();
+                if (!bestSolution)
+                {
+                    bestSolution = std::move(solution);
+                    solution = ScpSolution(m_Instance->elementCount(), m_Instance->subsetCount());
+                }
+                else if (solution.cost() < bestSolution->cost())
+                {
+                    std::swap(*bestSolution, solution);
+                }
+            }
+            return bestSolution;
+        };
 
-            foundSolutions.emplace_back(std::move(solution), solutionCost);
+        std::optional<ScpSolution> bestSolution;
+        if (!m_Executor || seeds.size() <= 1)
+        {
+            bestSolution = constructRange(0, seeds.size(), m_Scratch);
         }
+        else
+        {
+            bestSolution = m_Executor->parallelReduce(0, seeds.size(), 0, std::optional<ScpSolution>(),
+                [this, &constructRange](size_t begin, size_t end)
+                {
+                    ScratchArena scratch((2 * m_Instance->subsetCount() + m_Instance->elementCount()) * sizeof(int));
+                    return constructRange(begin, end, scratch);
+                },
+                [](std::optional<ScpSolution> best, std::optional<ScpSolution> candidate)
+                {
+                    return !best || (candidate && candidate->cost() < best->cost()) ? std::move(candidate) : std::move(best);
+                });
+        }
+        HE_STATS_ADD(m_Stats.restarts, seeds.size());
 
-        std::pair<std::unordered_set<int>, int> bestSolution = *Util::findMinSubsetCost(foundSolutions);
+        if (m_Trace)
+        {
+            int bestCost = 0;
+            for (size_t i = 0; i < costs.size(); ++i)
+            {
+                bestCost = i == 0 ? costs[i] : std::min(bestCost, costs[i]);
+                m_Trace->record(static_cast<long>(i), costs[i], bestCost);
+            }
+        }
 
-        return ScpResult{ bestSolution.second, bestSolution.first.size(), std::move(bestSolution.first) };
+        return bestSolution ? std::move(*bestSolution) : ScpSolution(m_Instance->elementCount(), m_Instance->subsetCount());
     }
 
-    std::unordered_set<int> Scp::greedyRandomized(int k, int rho)
+    template<typename Traits>
+    void BasicScp<Traits>::greedyRandomized(ScpSolution &solution, int k, int rho, ScratchArena &scratchArena)
     {
-        std::unordered_set<int> solution; // subset IDs
-        std::vector<int> localCosts(m_Costs); // local copy to avoid mangling the OG
-        std::vector<std::unordered_set<int>> localRelations(m_Relations);
-        std::unordered_set<int> remainingElements;
-        remainingElements.reserve(m_ElementCount);
-        for (int i = 0; i < m_ElementCount; ++i)
+        HE_PROFILE_FUNCTION();
+
+        std::pmr::memory_resource *scratch = scratchArena.resource();
+        std::pmr::vector<int> localCosts(m_Instance->subsetCount(), scratch); // local copy to avoid mangling the OG
+        for (int subset = 0; subset < m_Instance->subsetCount(); ++subset)
         {
-            remainingElements.insert(i);
+            localCosts[subset] = m_Instance->costs()[subset];
         }
 
         if (rho)
         {
             for (int &cost : localCosts)
             {
-                cost = RandomIntGenerator(cost - rho, cost + rho)();
+                // kept non-negative, so that a price never falls as elements get covered
+                cost = std::max(RandomIntGenerator(cost - rho, cost + rho)(), 0);
             }
         }
 
-        RandomIntGenerator randGen(0, k);
-        while (!remainingElements.empty())
+        // subsets are ranked by their cost per element they would newly cover. Covering elements only raises that price,
+        // so it is refreshed only when the subset comes up in the list, by counting its uncovered elements then, and the
+        // subsets with nothing left to cover are dropped there: each pick costs about k tree walks and counts, plus the
+        // subsets it made stale, not a pass over all of them nor over the relations of the elements it covers.
+        // With a dense coverage matrix, a count is a few words of the subset's column against the uncovered elements
+        const std::optional<CoverageMatrix> &denseCoverage = m_Instance->denseCoverage();
+        std::pmr::vector<Bitset::Word> uncoveredBits(scratch);
+        if (denseCoverage)
+        {
+            uncoveredBits.assign((m_Instance->elementCount() + Bitset::WORD_BITS - 1) / Bitset::WORD_BITS, ~Bitset::Word(0));
+        }
+        std::pmr::vector<int> uncoveredElements(m_Instance->subsetCount(), scratch); // Per subset, how many of its elements were uncovered when last counted
+        std::pmr::vector<int> countedAtPick(m_Instance->subsetCount(), 0, scratch); // Per subset, the pick at which it was last counted
+        std::pmr::vector<double> prices(m_Instance->subsetCount(), scratch);
+        for (int subset = 0; subset < m_Instance->subsetCount(); ++subset)
+        {
+            uncoveredElements[subset] = static_cast<int>(m_Instance->subsetElements()[subset].size());
+            prices[subset] = static_cast<double>(localCosts[subset]) / std::max(uncoveredElements[subset], 1);
+        }
+        TournamentTree<double> candidates(scratch);
+        candidates.assign(prices);
+        int pick = 0;
+        auto currentPrice = [&](int subset) -> std::optional<double>
         {
-            std::vector<int> subsetRestrictedCandidatesList = Util::findMinIndices(localCosts, k); // NOTE: k has to be less than n
-            int randomNumber = randGen();
-            int chosenSubsetCandidate = subsetRestrictedCandidatesList[randomNumber];
-            for (int i = 0; i < localRelations.size(); ++i)
+            if (countedAtPick[subset] != pick)
             {
-                if (localRelations[i].contains(chosenSubsetCandidate))
+                countedAtPick[subset] = pick;
+                if (denseCoverage)
                 {
-                    solution.insert(chosenSubsetCandidate);
-                    remainingElements.erase(i);
-                    localRelations[i].clear(); // mark the relation as used since the item has been selected
+                    uncoveredElements[subset] = denseCoverage->countContained(subset, uncoveredBits);
+                }
+                else
+                {
+                    uncoveredElements[subset] = 0;
+                    for (Index element : m_Instance->subsetElements()[subset])
+                    {
+                        uncoveredElements[subset] += solution.coverage(element) == 0;
+                    }
                 }
             }
-            localCosts[chosenSubsetCandidate] = std::numeric_limits<int>::max(); // marks the value as already used
-        }
-
-        return solution;
-    }
+            if (uncoveredElements[subset] == 0)
+            {
+                return std::nullopt;
+            }
+            return static_cast<double>(localCosts[subset]) / uncoveredElements[subset];
+        };
+        std::pmr::vector<int> subsetRestrictedCandidatesList(scratch);
 
-    ScpResult Scp::generateNeighbour(const ScpResult &current, int k)
-    {
-        switch (k)
+        solution.clear();
+        RandomRealGenerator randGen(0.0, 1.0);
+        while (!solution.isFeasible())
         {
-            case 0:
-                return randomNeighbour(current);
-            case 1:
-                return sequentialRemovalNeighbour(current);
-            case 2:
-                return bestNeighbour(current);
-            default:
-                return ScpResult();
+            candidates.smallest(k, subsetRestrictedCandidatesList, currentPrice);
+            if (subsetRestrictedCandidatesList.empty())
+            {
+                break; // some element is not contained by any subset
+            }
+            int listSize = static_cast<int>(subsetRestrictedCandidatesList.size());
+            int chosenSubsetCandidate = subsetRestrictedCandidatesList[std::min(static_cast<int>(randGen() * listSize), listSize - 1)];
+
+            const auto &elements = m_Instance->subsetElements()[chosenSubsetCandidate];
+            if (denseCoverage)
+            {
+                for (Index element : elements)
+                {
+                    uncoveredBits[element / Bitset::WORD_BITS] &= ~(Bitset::Word(1) << (element % Bitset::WORD_BITS));
+                }
+            }
+            solution.add(chosenSubsetCandidate, m_Instance->costs()[chosenSubsetCandidate], elements);
+            pick += 1;
         }
     }
 
-    ScpResult Scp::randomNeighbour(const ScpResult &current)
+    template<typename Traits>
+    void BasicScp<Traits>::randomNeighbour(ScpSolution &solution)
     {
-        RandomIntGenerator randSubsetGen(0, m_SubsetCount);
+        HE_PROFILE_FUNCTION();
+
+        RandomIntGenerator randSubsetGen(0, m_Instance->subsetCount());
 
-        std::unordered_set<int> subsetIDs = current.subsetIDs;
-        std::vector<int> subsetIDsList(subsetIDs.begin(), subsetIDs.end());
-        RandomIntGenerator randIndexGen(0, static_cast<int>(subsetIDsList.size()));
-        do
+        // removals are drawn from the original subsets only, so repeated attempts can not drain the solution
+        m_CandidatesScratch.assign(solution.subsets().begin(), solution.subsets().end());
+        RandomIntGenerator randIndexGen(0, static_cast<int>(m_CandidatesScratch.size()));
+        while (true)
         {
-            int subsetToRemove = subsetIDsList[randIndexGen()];
+            int subsetToRemove = m_CandidatesScratch[randIndexGen()];
             int subsetToAdd = randSubsetGen();
-            subsetIDs.erase(subsetToRemove);
-            subsetIDs.insert(subsetToAdd); // since the generated number could already be inside the set, add 0 or 1 new subset
-        }
-        while (!isSolutionFeasible(subsetIDs));
+            // the subset to remove may already be gone, and the generated one could already be inside the solution
+            solution.remove(subsetToRemove, m_Instance->costs()[subsetToRemove], m_Instance->subsetElements()[subsetToRemove]);
+            solution.add(subsetToAdd, m_Instance->costs()[subsetToAdd], m_Instance->subsetElements()[subsetToAdd]);
 
-        return { calculateSolutionCost(subsetIDs), subsetIDs.size(), std::move(subsetIDs) };
+            HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+            if (solution.isFeasible())
+            {
+                break;
+            }
+            HE_STATS_INCREMENT(m_Stats.repairCalls);
+        }
     }
 
-    ScpResult Scp::sequentialRemovalNeighbour(const ScpResult &current)
+    template<typename Traits>
+    void BasicScp<Traits>::sequentialRemovalNeighbour(ScpSolution &solution)
     {
-        RandomIntGenerator randSubsetGen(0, m_SubsetCount);
+        HE_PROFILE_FUNCTION();
+
+        RandomIntGenerator randSubsetGen(0, m_Instance->subsetCount());
 
-        ScpResult selectedNeighbour = current;
-        std::unordered_set<int> subsetIDs = selectedNeighbour.subsetIDs;
-        std::vector<int> subsetIDsList(selectedNeighbour.subsetIDs.begin(), selectedNeighbour.subsetIDs.end()); // Just for iteration, because of access violation when iterating the set
+        // iterate a snapshot, since applying and undoing moves reorders the selected subsets
+        m_CandidatesScratch.assign(solution.subsets().begin(), solution.subsets().end());
 
+        ScpMove selectedMove;
         int minCost = std::numeric_limits<int>::max();
-        for (int subset : subsetIDsList)
+        for (int subset : m_CandidatesScratch)
         {
             int subsetToAdd = randSubsetGen();
-            subsetIDs.erase(subset);
-            subsetIDs.insert(subsetToAdd);
-            int cost = calculateSolutionCost(subsetIDs);
-            if (cost <= minCost && isSolutionFeasible(subsetIDs))
+            ScpMove move{ subset, solution.contains(subsetToAdd) ? -1 : subsetToAdd };
+            int cost = solution.cost() - m_Instance->costs()[subset] + (move.added >= 0 ? m_Instance->costs()[move.added] : 0);
+            if (cost <= minCost)
             {
-                minCost = cost;
-                selectedNeighbour = { cost, subsetIDs.size(), subsetIDs };
+                applyMove(solution, move);
+                HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+                if (solution.isFeasible())
+                {
+                    minCost = cost;
+                    selectedMove = move;
+                }
+                // roll back to explore other options
+                undoMove(solution, move);
             }
-            // roll back to explore other options
-            subsetIDs.erase(subsetToAdd);
-            subsetIDs.insert(subset);
         }
 
-        return selectedNeighbour;
+        if (selectedMove.removed >= 0)
+        {
+            applyMove(solution, selectedMove);
+        }
     }
 
-    ScpResult Scp::bestNeighbour(const ScpResult &current)
+    template<typename Traits>
+    void BasicScp<Traits>::bestNeighbour(ScpSolution &solution)
     {
+        HE_PROFILE_FUNCTION();
+
         // sequentially eliminate one and add another (O(n^2)). choose the best one.
-        ScpResult bestNeighbour = current;
-        std::unordered_set<int> subsetIDs = bestNeighbour.subsetIDs;
-        std::vector<int> subsetIDsList(bestNeighbour.subsetIDs.begin(), bestNeighbour.subsetIDs.end()); // Just for iteration, because of access violation when iterating the set
+        m_CandidatesScratch.assign(solution.subsets().begin(), solution.subsets().end());
 
+        ScpMove bestMove;
         int minCost = std::numeric_limits<int>::max();
-        for (int subset : subsetIDsList)
+        for (int subset : m_CandidatesScratch)
         {
-            subsetIDs.erase(subset);
-            for (int i = 0; i < m_SubsetCount; ++i)
+            solution.remove(subset, m_Instance->costs()[subset], m_Instance->subsetElements()[subset]);
+            HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+            if (solution.cost() <= minCost && solution.isFeasible())
             {
-                subsetIDs.insert(i);
-                int cost = calculateSolutionCost(subsetIDs);
-                if (cost <= minCost && isSolutionFeasible(subsetIDs))
+                minCost = solution.cost();
+                bestMove = { subset, -1 };
+            }
+
+            for (int i = 0; i < m_Instance->subsetCount(); ++i)
+            {
+                if (solution.contains(i))
+                {
+                    continue;
+                }
+
+                int cost = solution.cost() + m_Instance->costs()[i];
+                if (cost > minCost)
+                {
+                    continue;
+                }
+
+                HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+                if (solution.coversAllUncovered(m_Instance->subsetElements()[i]))
                 {
                     minCost = cost;
-                    bestNeighbour = { cost, subsetIDs.size(), subsetIDs };
+                    bestMove = { subset, i };
+                }
+            }
+            solution.add(subset, m_Instance->costs()[subset], m_Instance->subsetElements()[subset]);
+        }
+
+        if (bestMove.removed >= 0)
+        {
+            applyMove(solution, bestMove);
+        }
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::flipNeighbour(ScpSolution &solution)
+    {
+        HE_PROFILE_FUNCTION();
+        constexpr int FLIP_ATTEMPTS = 8; // Subsets drawn per move
+
+        const auto &costs = m_Instance->costs();
+        const auto &subsetElements = m_Instance->subsetElements();
+        if (m_FlipScores.size() != static_cast<size_t>(m_Instance->subsetCount()))
+        {
+            m_FlipScores.assign(m_Instance->subsetCount(), 0);
+        }
+        if (m_FlipCoverageChange.size() != static_cast<size_t>(m_Instance->elementCount()))
+        {
+            m_FlipCoverageChange.assign(m_Instance->elementCount(), 0);
+        }
+
+        int dropped = -1;
+        int added = -1;
+        int redundant = -1; // Dropped too once the other two flips are done
+        int minDelta = std::numeric_limits<int>::max();
+        RandomIntGenerator randIndexGen(0, static_cast<int>(solution.size()));
+        for (int attempt = 0; attempt < FLIP_ATTEMPTS; ++attempt)
+        {
+            int subset = solution.subsets()[randIndexGen()];
+            m_FlipUncovered.clear();
+            for (Index element : subsetElements[subset])
+            {
+                if (solution.coverage(element) == 1)
+                {
+                    m_FlipUncovered.push_back(element);
+                }
+            }
+            if (m_FlipUncovered.empty())
+            {
+                if (-costs[subset] < minDelta)
+                {
+                    minDelta = -costs[subset];
+                    dropped = subset;
+                    added = -1;
+                    redundant = -1;
+                }
+                continue;
+            }
+
+            // every other subset containing an uncovered element is outside the solution, the dropped one is often listed too
+            Index droppedSubset = static_cast<Index>(subset);
+            for (Index element : m_FlipUncovered)
+            {
+                for (Index candidate : m_Instance->candidateLists()[element])
+                {
+                    if (candidate == droppedSubset)
+                    {
+                        continue;
+                    }
+                    if (m_FlipScores[candidate]++ == 0)
+                    {
+                        m_FlipScored.push_back(candidate);
+                    }
                 }
+            }
 
-                subsetIDs.erase(i);
+            for (Index element : subsetElements[subset])
+            {
+                m_FlipCoverageChange[element] -= 1;
             }
-            subsetIDs.insert(subset);
+            for (Index candidate : m_FlipScored)
+            {
+                int delta = costs[candidate] - costs[subset];
+                HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+                if (m_FlipScores[candidate] != static_cast<int>(m_FlipUncovered.size()))
+                {
+                    continue;
+                }
+                if (delta < minDelta)
+                {
+                    minDelta = delta;
+                    dropped = subset;
+                    added = candidate;
+                    redundant = -1;
+                }
+
+                // a subset becomes redundant if the candidate covers all of its elements that nothing else covers
+                for (Index element : subsetElements[candidate])
+                {
+                    m_FlipCoverageChange[element] += 1;
+                }
+                for (Index element : subsetElements[candidate])
+                {
+                    if (solution.coverage(element) != 1 || m_FlipCoverageChange[element] != 1)
+                    {
+                        continue;
+                    }
+                    const std::vector<Index> &relation = m_Instance->relations()[element];
+                    int other = *std::find_if(relation.begin(), relation.end(), [&solution](Index s) { return solution.contains(s); });
+                    if (delta - costs[other] >= minDelta)
+                    {
+                        continue;
+                    }
+                    const std::vector<Index> &otherElements = subsetElements[other];
+                    bool isRedundant = std::all_of(otherElements.begin(), otherElements.end(),
+                        [&](Index e) { return solution.coverage(e) + m_FlipCoverageChange[e] >= 2; });
+                    if (isRedundant)
+                    {
+                        minDelta = delta - costs[other];
+                        dropped = subset;
+                        added = candidate;
+                        redundant = other;
+                    }
+                }
+                for (Index element : subsetElements[candidate])
+                {
+                    m_FlipCoverageChange[element] -= 1;
+                }
+            }
+            for (Index element : subsetElements[subset])
+            {
+                m_FlipCoverageChange[element] += 1;
+            }
+            for (Index candidate : m_FlipScored)
+            {
+                m_FlipScores[candidate] = 0;
+            }
+            m_FlipScored.clear();
+        }
+
+        if (dropped >= 0)
+        {
+            applyMove(solution, { dropped, added });
+        }
+        if (redundant >= 0)
+        {
+            solution.remove(redundant, costs[redundant], subsetElements[redundant]);
         }
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::applyMove(ScpSolution &solution, const ScpMove &move)
+    {
+        solution.remove(move.removed, m_Instance->costs()[move.removed], m_Instance->subsetElements()[move.removed]);
+        if (move.added >= 0)
+        {
+            solution.add(move.added, m_Instance->costs()[move.added], m_Instance->subsetElements()[move.added]);
+        }
+    }
 
-        return bestNeighbour;
+    template<typename Traits>
+    void BasicScp<Traits>::undoMove(ScpSolution &solution, const ScpMove &move)
+    {
+        if (move.added >= 0)
+        {
+            solution.remove(move.added, m_Instance->costs()[move.added], m_Instance->subsetElements()[move.added]);
+        }
+        solution.add(move.removed, m_Instance->costs()[move.removed], m_Instance->subsetElements()[move.removed]);
     }
 
-    template<size_t size>
-    std::vector<int> Scp::positiveAssortativeMating(const std::bitset<size> &leader, const std::vector<std::bitset<size>> &population, int matesCount)
+    template<typename Traits>
+    std::pmr::vector<int> BasicScp<Traits>::positiveAssortativeMating(const Bitset &leader, const std::vector<BlgaIndividual> &population, int matesCount)
     {
-        std::priority_queue<int> bestHammingDistances;
-        std::unordered_map<int, int> mateIndexForHammingDistance;
+        HE_PROFILE_FUNCTION();
+
+        std::pmr::memory_resource *scratch = m_Scratch.resource();
+        std::priority_queue<int, std::pmr::vector<int>> bestHammingDistances{ std::less<int>(), std::pmr::vector<int>(scratch) };
+        std::pmr::unordered_map<int, int> mateIndexForHammingDistance(scratch);
         mateIndexForHammingDistance.reserve(matesCount);
 
         for (int i = 0; i < matesCount; ++i) // fill the priority queue first
         {
-            int hammingDistance = (population[i] ^ leader).count();
+            int hammingDistance = static_cast<int>(population[i].genes.hammingDistance(leader));
             bestHammingDistances.push(hammingDistance);
             mateIndexForHammingDistance[hammingDistance] = i;
         }
 
         for (int i = matesCount; i < population.size(); ++i)
         {
-            int hammingDistance = (population[i] ^ leader).count();
+            int hammingDistance = static_cast<int>(population[i].genes.hammingDistance(leader));
 
             int worstHammingDistance = bestHammingDistances.top();
             if (hammingDistance < worstHammingDistance)
@@ -394,7 +1216,7 @@ namespace Heuro
             }
         }
 
-        std::vector<int> mates;
+        std::pmr::vector<int> mates(scratch);
         mates.reserve(matesCount);
         for (auto &[_, index] : mateIndexForHammingDistance)
         {
@@ -404,45 +1226,62 @@ namespace Heuro
         return mates;
     }
 
-    template<size_t size>
-    std::bitset<size> Scp::randomParentUniformCrossover(
-        const std::bitset<size> &leader,
-        const std::vector<std::bitset<size>> &population,
-        const std::vector<int> &matesIndexes,
+    template<typename Traits>
+    void BasicScp<Traits>::randomParentUniformCrossover(
+        const BlgaIndividual &leader,
+        const std::vector<BlgaIndividual> &population,
+        const std::pmr::vector<int> &matesIndexes,
         double geneCopyProbability,
-        size_t usableBitsCount)
+        BlgaIndividual &offspring)
     {
-        RandomIntGenerator intGen(0, static_cast<int>(matesIndexes.size()));
-        std::bitset<size> randomMate = population[matesIndexes[intGen()]];
-
-        auto carryOverGenes = Util::genRandomBitset<size>(geneCopyProbability);
-        Util::truncateBitsetAfterIndex(carryOverGenes, usableBitsCount);
-        std::bitset<size> leaderOffspring = carryOverGenes & leader;
+        HE_PROFILE_FUNCTION();
 
-        carryOverGenes.flip();
-        Util::truncateBitsetAfterIndex(carryOverGenes, usableBitsCount);
-        std::bitset<size> randomMateOffspring = carryOverGenes & randomMate;
+        RandomIntGenerator intGen(0, static_cast<int>(matesIndexes.size()));
+        const Bitset &randomMate = population[matesIndexes[intGen()]].genes;
+        RandomBinaryGenerator carryOverGen(geneCopyProbability);
 
-        std::bitset<size> offspring = leaderOffspring | randomMateOffspring;
-        return offspring;
+        // the offspring's hash is the leader's, with the key of every gene that differs from the leader flipped
+        uint64_t hash = leader.hash;
+        offspring.genes.reset();
+        for (size_t i = 0; i < offspring.genes.size(); ++i)
+        {
+            bool leaderGene = leader.genes.test(i);
+            bool gene = carryOverGen() ? leaderGene : randomMate.test(i);
+            if (gene)
+            {
+                offspring.genes.set(i);
+            }
+            if (gene != leaderGene)
+            {
+                hash ^= ZobristHash::key(i);
+            }
+        }
+        offspring.hash = hash;
     }
 
-    template<size_t size>
-    void Scp::restrictedTournamentSelection(std::vector<std::bitset<size>> &population, const std::bitset<size> &solution, int sampleSize)
+    template<typename Traits>
+    void BasicScp<Traits>::restrictedTournamentSelection(
+        std::vector<BlgaIndividual> &population,
+        std::unordered_map<uint64_t, int> &populationHashes,
+        const BlgaIndividual &solution,
+        int sampleSize)
     {
-        std::vector<int> draftedChromosomesIndexes;
-        draftedChromosomesIndexes.reserve(sampleSize);
-        RandomIntGenerator intGen(0, sampleSize);
-        for (int i = 0; i < sampleSize; ++i)
+        HE_PROFILE_FUNCTION();
+
+        if (populationHashes.contains(solution.hash))
         {
-            draftedChromosomesIndexes.push_back(intGen());
+            HE_STATS_INCREMENT(m_Stats.duplicatesRejected);
+            return;
         }
 
+        RandomIntGenerator intGen(0, static_cast<int>(population.size()));
+
         int minDistance = std::numeric_limits<int>::max();
         int minDistanceIndex = 0;
-        for (int index : draftedChromosomesIndexes)
+        for (int i = 0; i < sampleSize; ++i)
         {
-            int hammingDistance = (population[index] ^ solution).count();
+            int index = intGen();
+            int hammingDistance = static_cast<int>(population[index].genes.hammingDistance(solution.genes));
             if (hammingDistance < minDistance)
             {
                 minDistance = hammingDistance;
@@ -450,42 +1289,124 @@ namespace Heuro
             }
         }
 
-        int minDistanceChromosomeCost = calculateSolutionCost(Util::bitsetToSet<size>(population[minDistanceIndex]));
-        int solutionCost = calculateSolutionCost(Util::bitsetToSet<size>(solution));
-
-        if (solutionCost < minDistanceChromosomeCost)
+        const BlgaIndividual &closest = population[minDistanceIndex];
+        bool isBetter = solution.feasible != closest.feasible ? solution.feasible : solution.cost < closest.cost;
+        if (isBetter)
         {
+            auto replaced = populationHashes.find(closest.hash);
+            if (--replaced->second == 0)
+            {
+                populationHashes.erase(replaced);
+            }
+            populationHashes[solution.hash] += 1;
             population[minDistanceIndex] = solution;
         }
     }
 
-    bool Scp::isSolutionFeasible(const std::unordered_set<int> &subsetIDs)
+    template<typename Traits>
+    void BasicScp<Traits>::evaluateIndividual(BlgaIndividual &individual)
     {
-        std::unordered_set<int> remainingElements;
-        remainingElements.reserve(m_ElementCount);
-        for (int i = 0; i < m_ElementCount; ++i)
+        individual.hash = ZobristHash::of(individual.genes);
+        individual.cost = calculateSolutionCost(individual.genes);
+        individual.feasible = isSolutionFeasible(individual.genes);
+        individual.selectedCount = static_cast<int>(individual.genes.count());
+    }
+
+    template<typename Traits>
+    void BasicScp<Traits>::evaluateIndividualCached(BlgaIndividual &individual)
+    {
+        HE_STATS_INCREMENT(m_Stats.cacheLookups);
+
+        Evaluation evaluation;
+        if (m_EvaluationCache->find(individual.hash, evaluation))
         {
-            remainingElements.insert(i);
+            HE_STATS_INCREMENT(m_Stats.cacheHits);
+            individual.cost = evaluation.cost;
+            individual.feasible = evaluation.feasible;
+            individual.selectedCount = evaluation.selectedCount;
+            return;
         }
 
-        for (int i = 0; i < m_Relations.size(); ++i)
+        individual.cost = calculateSolutionCost(individual.genes);
+        individual.feasible = isSolutionFeasible(individual.genes);
+        individual.selectedCount = static_cast<int>(individual.genes.count());
+        m_EvaluationCache->insert(individual.hash, { individual.cost, individual.selectedCount, individual.feasible });
+    }
+
+    template<typename Traits>
+    bool BasicScp<Traits>::isSolutionFeasible(const Bitset &subsets)
+    {
+        HE_STATS_INCREMENT(m_Stats.feasibilityChecks);
+        if (m_Instance->denseCoverage())
+        {
+            return m_Instance->denseCoverage()->coversAll(subsets);
+        }
+
+        for (const auto &relation : m_Instance->relations())
         {
-            for (int subset : subsetIDs)
+            bool covered = std::any_of(relation.begin(), relation.end(), [&subsets](int subset) { return subsets.test(subset); });
+            if (!covered)
             {
-                if (m_Relations[i].contains(subset))
-                {
-                    remainingElements.erase(i); // if the element is contained by the subset, mark it as used
-                    break;
-                }
+                return false;
             }
         }
 
-        return remainingElements.empty(); // all elements must be taken into account for the solution to be feasible
+        return true;
     }
 
-    int Scp::calculateSolutionCost(const std::unordered_set<int> &subsetIDs)
+    template<typename Traits>
+    int BasicScp<Traits>::calculateSolutionCost(const Bitset &subsets)
     {
-        return std::reduce(subsetIDs.begin(), subsetIDs.end(), 0, [this](int a, int b) { return a + m_Costs[b]; });
+        if constexpr (Traits::UNICOST)
+        {
+            return static_cast<int>(subsets.count());
+        }
+        if (m_Instance->denseCoverage())
+        {
+            return m_Instance->denseCoverage()->cost(subsets);
+        }
+
+        int cost = 0;
+        subsets.forEachSetBit([this, &cost](size_t subset) { cost += m_Instance->costs()[subset]; });
+        return cost;
     }
 
-}
\ No newline at end of file
+    std::unique_ptr<ScpSolver> ScpSolver::create(const ScpInput &input, std::pmr::memory_resource *scratchUpstream)
+    {
+        return create(ScpInstance::create(input), scratchUpstream);
+    }
+
+    template<typename Traits>
+    static std::unique_ptr<ScpSolver> createFor(const std::shared_ptr<const ScpInstance> &instance, std::pmr::memory_resource *scratchUpstream)
+    {
+        if (auto typed = std::dynamic_pointer_cast<const BasicScpInstance<Traits>>(instance))
+        {
+            return std::make_unique<BasicScp<Traits>>(std::move(typed), scratchUpstream);
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<ScpSolver> ScpSolver::create(std::shared_ptr<const ScpInstance> instance, std::pmr::memory_resource *scratchUpstream)
+    {
+        std::unique_ptr<ScpSolver> solver;
+        if (!solver) solver = createFor<ScpTraitsU16>(instance, scratchUpstream);
+        if (!solver) solver = createFor<ScpTraitsU16Wide>(instance, scratchUpstream);
+        if (!solver) solver = createFor<ScpTraitsU16Unicost>(instance, scratchUpstream);
+        if (!solver) solver = createFor<ScpTraitsU32>(instance, scratchUpstream);
+        if (!solver) solver = createFor<ScpTraitsU32Wide>(instance, scratchUpstream);
+        if (!solver) solver = createFor<ScpTraitsU32Unicost>(instance, scratchUpstream);
+        if (!solver)
+        {
+            throw std::invalid_argument("No solver for the representation " + instance->representation());
+        }
+        return solver;
+    }
+
+    template class BasicScp<ScpTraitsU16>;
+    template class BasicScp<ScpTraitsU16Wide>;
+    template class BasicScp<ScpTraitsU16Unicost>;
+    template class BasicScp<ScpTraitsU32>;
+    template class BasicScp<ScpTraitsU32Wide>;
+    template class BasicScp<ScpTraitsU32Unicost>;
+
+}
@@ -1,26 +1,67 @@
 #pragma once
 
+#include "ScpInstance.hpp"
+#include "ScpSolver.hpp"
+
+#include "util/Checkpoint.hpp"
+#include "util/CoverageMatrix.hpp"
 #include "util/Data.hpp"
+#include "util/ScpSolution.hpp"
+#include "util/ScpTraits.hpp"
+#include "util/ScratchArena.hpp"
+
+#include "debug/SearchStats.hpp"
 
 #include <vector>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
-#include <bitset>
 
 namespace Heuro
 {
 
-    class Scp
+    class ConvergenceTrace;
+
+    /**
+     * @brief The SCP solver, specialized at compile time on the representation of the instance (see ScpTraits).
+     * Narrower indices and costs shrink the coverage arrays and column lists the algorithms walk, and unicost instances skip
+     * cost lookups entirely. The algorithms are documented in ScpSolver.
+     * The solver holds the state of its runs (scratch memory, stats, warm starts...) and reads the instance through a shared
+     * BasicScpInstance, so solvers of the same instance can run at once on different threads.
+     */
+    template<typename Traits>
+    class BasicScp : public ScpSolver
     {
+        friend class ScpBenchmark; // heuro_bench times the private kernels in isolation
+
     private:
-        int m_ElementCount = 0; // m
-        int m_SubsetCount = 0; // n
-        std::vector<int> m_Costs; // Cost of each subset
-        std::vector<std::unordered_set<int>> m_Relations; // Relations between each element and the subsets that contain it (e.g index 1: 2, 4 means subsets 2 and 4 contain element 1)
+        using Index = typename Traits::Index;
+        using ScpSolution = BasicScpSolution<Index>;
+        using Instance = BasicScpInstance<Traits>;
+
+        std::shared_ptr<const Instance> m_Instance; // Read-only, possibly shared with other solvers
+
+        std::vector<Index> m_CandidatesScratch; // Reused by the neighbourhoods to iterate a snapshot of the selected subsets
+        std::vector<int> m_FlipScores; // Per subset, how many of the elements uncovered by a drop it covers, zero between moves
+        std::vector<int> m_FlipCoverageChange; // Per element, how a move being evaluated changes its coverage, zero between moves
+        std::vector<Index> m_FlipUncovered; // Elements uncovered by the drop being evaluated
+        std::vector<Index> m_FlipScored; // Subsets whose score is not zero
+        ScratchArena m_Scratch; // Temporary per-iteration memory of every algorithm, released once each iteration ends
+
+        SearchStats m_Stats; // Counters of the last run, reset when an algorithm starts
+        ConvergenceTrace *m_Trace = nullptr;
+        std::shared_ptr<EvaluationCache> m_EvaluationCache; // Evaluations of BLGA individuals, keyed by their Zobrist hash
+        Executor *m_Executor = nullptr;
+        std::vector<std::vector<Index>> m_InitialSolutions; // Subsets of each warm start solution, sorted
+        IncumbentBoard *m_Board = nullptr; // Best solution shared with other solvers and processes, see setIncumbentBoard
+        std::unique_ptr<CheckpointWriter> m_Checkpoints; // Saves the state of the local searches, see setCheckpoint
 
         /**
          * @brief Calculates several solutions using a greedy randomized algorithm.
          * If given a noise factor, each cost is modified by +/- the noise factor.
+         * With an executor, the constructions run in parallel. Each one is seeded on its own, so the result is the same either way.
          * The algorithm is based on the one proposed by Mauricio G.C. Resende and Celso C. Ribeiro
          * in "GRASP: Greedy Randomized Adaptive SearchProcedures", under the "A template for Grasp" section.
          *
@@ -30,140 +71,223 @@ namespace Heuro
          *
          * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
          */
-        ScpResult graspInternal(int maxSolCount, int k, int rho = 0);
-        std::unordered_set<int> greedyRandomized(int k, int rho);
+        ScpSolution graspInternal(int maxSolCount, int k, int rho = 0);
+
+        /**
+         * @brief Selects the given subsets and, if they leave elements uncovered, the cheapest subset of each of those.
+         */
+        ScpSolution toCompleteSolution(const std::vector<Index> &subsets);
+
+        /**
+         * @brief The cheapest of the initial solutions once completed, or nothing if there are none.
+         */
+        std::optional<ScpSolution> bestInitialSolution();
+
+        /**
+         * @brief The solution the local searches start from: the best initial solution, or else a greedy construction.
+         */
+        ScpSolution startingSolution();
+
+        /**
+         * @brief Replaces the solution with the best initial one if that one is cheaper.
+         */
+        void keepBestInitialSolution(ScpSolution &solution);
+
+        /**
+         * @brief Whether the given cost beats the solution of the incumbent board, if the solver has one.
+         */
+        bool beatsBoard(int cost) const;
+
+        /**
+         * @brief Publishes the solution to the incumbent board if it beats the board's.
+         */
+        void publishToBoard(const ScpSolution &solution);
+
+        /**
+         * @brief The solution of the incumbent board, completed like the initial solutions, if it is cheaper than the given cost.
+         */
+        std::optional<ScpSolution> boardSolutionBelow(int cost);
+
+        /**
+         * @brief Publishes the solution of a local search to the incumbent board if it beats the board's, or restarts the
+         * search from the board's solution if that one beats bestCost, the best cost of the run so far.
+         *
+         * @return Whether the solution was replaced with the board's.
+         */
+        bool exchangeWithBoard(ScpSolution &solution, int bestCost);
+
+        /**
+         * @brief Starts checkpointing a run, if the solver checkpoints its runs.
+         *
+         * @return The checkpoint the run continues from, if the file holds one.
+         * @throws std::runtime_error If the file holds the checkpoint of another run or instance.
+         */
+        std::optional<SearchCheckpoint> beginCheckpointedRun(const std::string &algorithm, const std::string &parameters);
+
+        /**
+         * @brief A checkpoint of the run with the fields every algorithm saves: its identity, elapsed time and random state.
+         */
+        SearchCheckpoint newCheckpoint(const std::string &algorithm, const std::string &parameters, long elapsedMillis) const;
+
+        /**
+         * @brief Ends a checkpointed run, removing its checkpoint.
+         */
+        void finishCheckpointedRun();
+
+        /**
+         * @brief Deselects every subset whose elements are all covered by other subsets, most expensive first.
+         */
+        void removeRedundantSubsets(ScpSolution &solution);
+
+        /**
+         * @brief Builds a solution from scratch into the given one, reusing its storage. Scratch memory is taken from the given
+         * arena, the solver's own one unless the construction runs on another thread.
+         */
+        void greedyRandomized(ScpSolution &solution, int k, int rho, ScratchArena &scratch);
+
+        /**
+         * @brief Runs VNS from the given feasible solution and returns the best one found. The run is checkpointed under the
+         * given algorithm name, and continues from its checkpoint if there is one.
+         */
+        ScpSolution vnsInternal(ScpSolution currentSolution, long maxRuntime, const std::string &algorithm);
+
+        /**
+         * @brief The neighbourhoods of the local searches (see LocalSearch), which move the given solution to a neighbour,
+         * editing it in place. The solution must be feasible, and it is left feasible.
+         * The neighbourhoods do not allocate once the solver's scratch storage has grown to the solution size.
+         */
+        void randomNeighbour(ScpSolution &solution);
+        void sequentialRemovalNeighbour(ScpSolution &solution);
+        void bestNeighbour(ScpSolution &solution);
+
+        /**
+         * @brief Applies the cheapest 2-flip or 3-flip move found from a few randomly drawn subsets, after the ones of
+         * M. Yagiura, M. Kishida and T. Ibaraki in "A 3-flip neighborhood local search for the set covering problem". Each
+         * drawn subset is dropped, and the subsets that cover every element left uncovered are found by scoring the candidate
+         * lists of those elements (see BasicScpInstance::candidateLists): adding one of them is a 2-flip, and also dropping
+         * the most expensive subset it makes redundant a 3-flip. A drawn subset that is redundant itself is just dropped.
+         * The solution is left as it is if no drawn subset has a move.
+         */
+        void flipNeighbour(ScpSolution &solution);
 
-        ScpResult generateNeighbour(const ScpResult& current, int k);
-        ScpResult randomNeighbour(const ScpResult &current);
-        ScpResult sequentialRemovalNeighbour(const ScpResult &current);
-        ScpResult bestNeighbour(const ScpResult &current);
+        void applyMove(ScpSolution &solution, const ScpMove &move);
+        void undoMove(ScpSolution &solution, const ScpMove &move);
 
         /**
          * @brief Goes through the population and gets the indexes of the chromosomes with the highest Hamming distance to the leader,
          * i.e. the most similar ones.
          *
-         * @tparam size The size of the bitsets.
          * @param population The population in which to search for the mates.
          * @param leader The leader chromosome.
          * @param matesCount The amount of mates chosen.
          *
-         * @return The indexes of the chosen mates within the population.
+         * @return The indexes of the chosen mates within the population, allocated from the scratch arena.
          */
-        template<size_t size>
-        std::vector<int> positiveAssortativeMating(const std::bitset<size> &leader, const std::vector<std::bitset<size>> &population, int matesCount);
+        std::pmr::vector<int> positiveAssortativeMating(const Bitset &leader, const std::vector<BlgaIndividual> &population, int matesCount);
 
         /**
          * @brief Crossover operator that generates an offspring using one randomly selected parent, copying the genes of the leader with a given probability.
+         * The offspring's hash is derived from the leader's by the genes that differ from it, so it is never computed from scratch.
          *
-         * @tparam size The size of the bitsets.
-         * @param leader The leader chromosome.
+         * @param leader The leader, with its hash computed.
          * @param population The population of chromosomes.
          * @param matesIndexes The indexes of the chosen mates for the crossover.
          * @param geneCopyProbability The probability to copy each gene of the leader.
-         * @param usableBitsCount The amount of bits to be used from the bitsets. Should be less than template param size.
-         *
-         * @return The offspring of the process.
+         * @param offspring Where the genes and hash of the offspring are written. Its genes must have as many bits as there are subsets.
          */
-        template<size_t size>
-        std::bitset<size> randomParentUniformCrossover(
-            const std::bitset<size> &leader,
-            const std::vector<std::bitset<size>> &population,
-            const std::vector<int> &matesIndexes,
+        void randomParentUniformCrossover(
+            const BlgaIndividual &leader,
+            const std::vector<BlgaIndividual> &population,
+            const std::pmr::vector<int> &matesIndexes,
             double geneCopyProbability,
-            size_t usableBitsCount);
+            BlgaIndividual &offspring);
 
         /**
-         * @brief Compares the solution to a randomly drafted group from the population, replacing the most similar one with it.
+         * @brief Compares the solution to a randomly drafted group from the population, replacing the most similar one with it
+         * if the solution is better (feasible individuals beat infeasible ones, then lower cost wins). An individual identical
+         * to one already in the population is rejected, so it cannot fill the population with copies.
          *
-         * @tparam size The size of the bitsets.
          * @param population The population of chromosomes.
-         * @param solution The solution to insert into the population.
+         * @param populationHashes How many individuals of the population have each hash. Kept up to date with the population.
+         * @param solution The solution to insert into the population, with its metadata already computed.
          * @param sampleSize The amount of randomly selected chromosomes from the population.
          */
-        template<size_t size>
-        void restrictedTournamentSelection(std::vector<std::bitset<size>> &population, const std::bitset<size> &solution, int sampleSize);
-
-        bool isSolutionFeasible(const std::unordered_set<int> &subsetIDs);
-        int calculateSolutionCost(const std::unordered_set<int> &subsetIDs);
-
-    public:
-        Scp(int elementCount, int subsetCount, std::vector<int> costs, std::vector<std::unordered_set<int>> relations);
+        void restrictedTournamentSelection(
+            std::vector<BlgaIndividual> &population,
+            std::unordered_map<uint64_t, int> &populationHashes,
+            const BlgaIndividual &solution,
+            int sampleSize);
 
         /**
-         * @brief Calculates a solution using a simple greedy algorithm.
-         *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         * @brief Computes the hash, cost, feasibility and selected subset count of an individual from its genes.
          */
-        ScpResult constructive();
+        void evaluateIndividual(BlgaIndividual &individual);
 
         /**
-         * @brief Calculates several solutions using a randomized greedy algorithm, and later chooses the best one.
-         * During each iteration, it chooses an element at random from the k elements with less cost.
-         *
-         * @param maxSolCount The maximum number of iterations the algorithm is allowed.
-         * @param k The size of the RCL from which an element will be chosen at random.
-         *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         * @brief Like evaluateIndividual, but keeps the hash the individual already has (see randomParentUniformCrossover) and
+         * only evaluates the genes when the evaluation cache does not hold the individual.
          */
-        ScpResult grasp(int maxSolCount, int k);
+        void evaluateIndividualCached(BlgaIndividual &individual);
 
-        /**
-         * @brief Calculates several solutions using a randomized greedy algorithm and noise, and later chooses the best one.
-         * During each iteration, it chooses an element at random from the k elements with less cost.
-         * Also, every cost is modified by +/- the noise factor.
-         *
-         * @param maxSolCount The maximum number of iterations the algorithm is allowed.
-         * @param k The size of the RCL from which an element will be chosen at random.
-         * @param rho The noise factor.
-         *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
-         */
-        ScpResult graspWithNoise(int maxSolCount, int k, int rho);
+        bool isSolutionFeasible(const Bitset &subsets);
+        int calculateSolutionCost(const Bitset &subsets);
 
+    public:
         /**
-         * @brief Tries to find an as-close as possible optimal solution by using a local search meta-heuristic capable of escaping local optima.
-         * It allows hill-climbing moves in hopes of finding the global optimum.
-         * It simulates the process of physical annealing with solids, in which a crystalline solid is heated and then allowed to cool very slowly
-         * until it achieves its most regular possible crystal lattice configuration, and thus is free of crystal defects.
-         *
-         * (Based on the algorithm proposed in 'Handbook of Metaheuristics', by Michel Gendreau and Jean-Yves Potvin).
-         *
-         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
-         * @param initTemp The initial temperature of the simulation.
-         * @param iterPerTemp The number of iterations executed at each temperature.
-         * @param tempCoolingSchedule The cooling function. It accepts the initial one and the current iteration number, and returns the new temp..
-         *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         * @param instance The instance to solve, which the solver only reads and may share with any other solvers.
+         * @param scratchUpstream The resource from which the solver's scratch arena takes its memory when it needs to grow.
          */
-        ScpResult simulatedAnnealing(long maxRuntime, double initTemp, int iterPerTemp, const std::function<double(double, int)> &tempCoolingSchedule);
+        explicit BasicScp(std::shared_ptr<const Instance> instance, std::pmr::memory_resource *scratchUpstream = std::pmr::get_default_resource());
 
         /**
-         * @brief Tries to find an as-close as possible optimal solution by using a variable neighbourhood search method.
-         * In it, a neighbour is generated and accepted in case it improves on the current solution.
-         * Otherwise, the search continues in another neighbourhood (max. 3 different neighbourhoods).
-         *
-         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         * @brief Builds a solver with an instance of its own.
          *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         * @param scratchUpstream The resource from which the solver's scratch arena takes its memory when it needs to grow.
          */
-        ScpResult vns(long maxRuntime);
+        BasicScp(
+            int elementCount,
+            int subsetCount,
+            const std::vector<int> &costs,
+            const std::vector<std::unordered_set<int>> &relations,
+            std::pmr::memory_resource *scratchUpstream = std::pmr::get_default_resource());
 
-        /**
-         * @brief Calculates a solution using a binary-coded local genetic algorithm (BLGA), a hybrid steady-state genetic algorithm that
-         * combines the speed and power of a genetic algorithm with the precision of a local search procedure. It makes use of
-         * positive assortative mating to select parents near the current best solution, random-parent uniform crossover to create an offspring
-         * relatively near the current search space, and restricted tournament selection (RTS) to improve the quality of the population.
-         *
-         * (Based on the algorithm proposed in 'Local Search Based on Genetic Algorithms', by Carlos Garcia-Martinez and Manuel Lozano).
-         *
-         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
-         * @param matesCount The number of mates selected from the population using positive assortative mating.
-         * @param geneCopyProbability The probability of a gene from the best solution to be carried over to its offspring.
-         * @param rtsSampleSize The number of randomly selected individuals from the population for the RTS procedure.
-         *
-         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
-         */
-        ScpResult blga(long maxRuntime, int populationSize, int matesCount, double geneCopyProbability, int rtsSampleSize);
+        std::string representation() const override;
+        std::shared_ptr<const ScpInstance> instance() const override;
+
+        const MemoryStats &scratchMemoryStats() const override;
+        void resetScratchMemoryStats() override;
+        const SearchStats &lastRunStats() const override;
+        void setConvergenceTrace(ConvergenceTrace *trace) override;
+        void setEvaluationCache(std::shared_ptr<EvaluationCache> cache) override;
+        const std::shared_ptr<EvaluationCache> &evaluationCache() const override;
+        void setExecutor(Executor *executor) override;
+        void setInitialSolutions(const std::vector<ScpResult> &solutions) override;
+        void setIncumbentBoard(IncumbentBoard *board) override;
+        void setCheckpoint(const std::string &path, long intervalMillis) override;
+        bool applyEdits(const ScpEdits &edits) override;
+        ScpResult reoptimize(const ScpResult &previousSolution, long maxRuntime) override;
+
+        ScpResult constructive() override;
+        ScpResult grasp(int maxSolCount, int k) override;
+        ScpResult graspWithNoise(int maxSolCount, int k, int rho) override;
+        ScpResult simulatedAnnealing(long maxRuntime, double initTemp, int iterPerTemp, const std::function<double(double, int)> &tempCoolingSchedule) override;
+        ScpResult vns(long maxRuntime) override;
+        ScpResult blga(long maxRuntime, int populationSize, int matesCount, double geneCopyProbability, int rtsSampleSize) override;
+        ScpResult coreProblem(long maxRuntime, int columnsPerRow, int pricingRounds, const std::function<ScpResult(ScpSolver &core, long roundRuntime)> &algorithm) override;
+        ScpExactResult branchAndBound(long maxRuntime, long maxNodes = 0, int threadCount = 1) override;
     };
 
-}
\ No newline at end of file
+    extern template class BasicScp<ScpTraitsU16>;
+    extern template class BasicScp<ScpTraitsU16Wide>;
+    extern template class BasicScp<ScpTraitsU16Unicost>;
+    extern template class BasicScp<ScpTraitsU32>;
+    extern template class BasicScp<ScpTraitsU32Wide>;
+    extern template class BasicScp<ScpTraitsU32Unicost>;
+
+    /**
+     * @brief The solver for any instance, with 32-bit indices and costs. Prefer ScpSolver::create, which picks the narrowest
+     * representation for the instance.
+     */
+    using Scp = BasicScp<ScpTraitsU32Wide>;
+
+}
@@ -0,0 +1,492 @@
+#include "Scp.hpp"
+
+#include "util/Executor.hpp"
+#include "util/IncumbentBoard.hpp"
+#include "util/Lagrangian.hpp"
+
+#include "debug/Instrumentor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+
+namespace Heuro
+{
+
+    struct BranchAndBoundNode
+    {
+        double bound = 0.0; // Lower bound of every solution in the node, including the cost of its fixed subsets
+        std::vector<signed char> fixedSubsets; // 1: forced into the solution, -1: forced out, 0: free
+        std::vector<double> multipliers; // Of the parent, to warm start the relaxation
+
+        bool operator<(const BranchAndBoundNode &other) const
+        {
+            return bound > other.bound; // makes std::priority_queue pop the lowest bound first
+        }
+    };
+
+    /**
+     * @brief Nodes waiting to be explored by one worker. Other workers steal from it once their own queue is empty.
+     */
+    struct BranchAndBoundQueue
+    {
+        std::mutex mutex;
+        std::priority_queue<BranchAndBoundNode> nodes;
+    };
+
+    /**
+     * @brief The state of a branch-and-bound search shared by all of its workers.
+     */
+    template<typename Traits>
+    class BranchAndBoundSearch
+    {
+    private:
+        using Index = typename Traits::Index;
+
+        static constexpr int ROOT_SUBGRADIENT_ITERATIONS = 2000;
+        static constexpr int NODE_SUBGRADIENT_ITERATIONS = 200;
+        static constexpr double EPSILON = 1e-6;
+
+        int m_ElementCount;
+        int m_SubsetCount;
+        const CostTable<typename Traits::Cost> &m_Costs;
+        const std::vector<std::vector<Index>> &m_Relations;
+        const std::vector<std::vector<Index>> &m_SubsetElements;
+
+        std::chrono::time_point<std::chrono::steady_clock> m_Deadline;
+        long m_MaxNodes;
+
+        std::vector<BranchAndBoundQueue> m_Queues;
+        std::atomic<int> m_BusyWorkers = 0; // Workers holding a node or trying to take one
+        std::atomic<long> m_NodeCount = 0;
+        std::atomic<bool> m_Stopped = false;
+
+        std::mutex m_IncumbentMutex;
+        std::atomic<int> m_IncumbentCost;
+        std::vector<int> m_Incumbent;
+        double m_UnexploredBound = std::numeric_limits<double>::max(); // Lowest bound of the nodes dropped when stopping, guarded by m_IncumbentMutex
+        IncumbentBoard *m_Board; // Shares the incumbent with other processes, or nullptr
+
+        /**
+         * @brief Whether no solution within the given bound can improve the incumbent, knowing that costs are integral.
+         */
+        bool canPrune(double bound) const
+        {
+            return std::ceil(bound - EPSILON) >= m_IncumbentCost.load(std::memory_order_relaxed);
+        }
+
+        void offerIncumbent(const std::vector<int> &subsets, int cost)
+        {
+            if (cost >= m_IncumbentCost.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            {
+                std::lock_guard lock(m_IncumbentMutex);
+                if (cost >= m_IncumbentCost.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                m_Incumbent = subsets;
+                m_IncumbentCost.store(cost, std::memory_order_relaxed);
+            }
+            if (m_Board && cost < m_Board->bestCost())
+            {
+                m_Board->publish({ cost, subsets.size(), std::unordered_set<int>(subsets.begin(), subsets.end()) });
+            }
+        }
+
+        /**
+         * @brief Takes the solution of the board as incumbent once it is cheaper, so that the workers prune against the best
+         * solution of every process. It is checked to cover the instance first, since the bound proven relies on it.
+         */
+        void adoptBoardIncumbent()
+        {
+            if (!m_Board || m_Board->bestCost() >= m_IncumbentCost.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            std::optional<ScpResult> boardResult = m_Board->read();
+            if (!boardResult)
+            {
+                return;
+            }
+
+            std::vector<int> subsets(boardResult->subsetIDs.begin(), boardResult->subsetIDs.end());
+            std::vector<bool> covered(m_ElementCount, false);
+            int cost = 0;
+            for (int subset : subsets)
+            {
+                cost += m_Costs[subset];
+                for (Index element : m_SubsetElements[subset])
+                {
+                    covered[element] = true;
+                }
+            }
+            if (std::find(covered.begin(), covered.end(), false) == covered.end())
+            {
+                offerIncumbent(subsets, cost);
+            }
+        }
+
+        void dropUnexplored(double bound)
+        {
+            std::lock_guard lock(m_IncumbentMutex);
+            m_UnexploredBound = std::min(m_UnexploredBound, bound);
+        }
+
+        bool takeNode(int worker, BranchAndBoundNode &node)
+        {
+            for (size_t offset = 0; offset < m_Queues.size(); ++offset)
+            {
+                BranchAndBoundQueue &queue = m_Queues[(worker + offset) % m_Queues.size()];
+                std::lock_guard lock(queue.mutex);
+                if (!queue.nodes.empty())
+                {
+                    node = std::move(const_cast<BranchAndBoundNode &>(queue.nodes.top()));
+                    queue.nodes.pop();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool hasQueuedNodes()
+        {
+            for (BranchAndBoundQueue &queue : m_Queues)
+            {
+                std::lock_guard lock(queue.mutex);
+                if (!queue.nodes.empty())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void pushNode(int worker, BranchAndBoundNode node)
+        {
+            BranchAndBoundQueue &queue = m_Queues[worker];
+            std::lock_guard lock(queue.mutex);
+            queue.nodes.push(std::move(node));
+        }
+
+        /**
+         * @brief Covers the elements left uncovered by the fixed subsets with the free subsets of lowest cost per newly covered
+         * element, then drops the subsets made redundant, most expensive first.
+         */
+        void greedyHeuristic(const std::vector<signed char> &fixedSubsets, std::vector<int> &coverage, std::vector<int> &solution)
+        {
+            std::vector<int> uncoveredPerSubset(m_SubsetCount, 0);
+            int uncoveredCount = 0;
+            for (int element = 0; element < m_ElementCount; ++element)
+            {
+                if (coverage[element] == 0)
+                {
+                    uncoveredCount += 1;
+                    for (Index subset : m_Relations[element])
+                    {
+                        uncoveredPerSubset[subset] += 1;
+                    }
+                }
+            }
+
+            while (uncoveredCount > 0)
+            {
+                int chosen = -1;
+                double chosenScore = std::numeric_limits<double>::max();
+                for (int subset = 0; subset < m_SubsetCount; ++subset)
+                {
+                    if (fixedSubsets[subset] == 0 && uncoveredPerSubset[subset] > 0)
+                    {
+                        double score = static_cast<double>(m_Costs[subset]) / uncoveredPerSubset[subset];
+                        if (score < chosenScore)
+                        {
+                            chosen = subset;
+                            chosenScore = score;
+                        }
+                    }
+                }
+
+                solution.push_back(chosen);
+                for (Index element : m_SubsetElements[chosen])
+                {
+                    if (coverage[element]++ == 0)
+                    {
+                        uncoveredCount -= 1;
+                        for (Index subset : m_Relations[element])
+                        {
+                            uncoveredPerSubset[subset] -= 1;
+                        }
+                    }
+                }
+            }
+
+            std::sort(solution.begin(), solution.end(), [this](int i, int j) { return m_Costs[i] > m_Costs[j]; });
+            auto isRedundant = [&](int subset)
+            {
+                const auto &elements = m_SubsetElements[subset];
+                if (std::any_of(elements.begin(), elements.end(), [&coverage](int element) { return coverage[element] < 2; }))
+                {
+                    return false;
+                }
+                for (int element : elements)
+                {
+                    coverage[element] -= 1;
+                }
+                return true;
+            };
+            solution.erase(std::remove_if(solution.begin(), solution.end(), isRedundant), solution.end());
+        }
+
+        /**
+         * @brief Bounds a node, fixes what its reduced costs allow, improves the incumbent and branches.
+         */
+        void exploreNode(int worker, LagrangianRelaxation<Traits> &relaxation, BranchAndBoundNode &node, std::vector<double> &reducedCosts)
+        {
+            HE_PROFILE_FUNCTION();
+
+            int fixedCost = 0;
+            std::vector<int> coverage(m_ElementCount, 0);
+            std::vector<int> solution;
+            for (int subset = 0; subset < m_SubsetCount; ++subset)
+            {
+                if (node.fixedSubsets[subset] > 0)
+                {
+                    fixedCost += m_Costs[subset];
+                    solution.push_back(subset);
+                    for (Index element : m_SubsetElements[subset])
+                    {
+                        coverage[element] += 1;
+                    }
+                }
+            }
+
+            // every element left uncovered must still have a free subset
+            auto isCoverable = [&]()
+            {
+                for (int element = 0; element < m_ElementCount; ++element)
+                {
+                    if (coverage[element] == 0 &&
+                        std::none_of(m_Relations[element].begin(), m_Relations[element].end(), [&node](int subset) { return node.fixedSubsets[subset] == 0; }))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            if (!isCoverable())
+            {
+                return;
+            }
+
+            bool isRoot = node.multipliers.empty();
+            relaxation.setFixedSubsets(&node.fixedSubsets);
+            LagrangianBound relaxed = relaxation.optimize(
+                m_IncumbentCost.load(std::memory_order_relaxed) - fixedCost,
+                isRoot ? relaxation.initialMultipliers() : std::move(node.multipliers),
+                isRoot ? ROOT_SUBGRADIENT_ITERATIONS : NODE_SUBGRADIENT_ITERATIONS);
+            node.bound = std::max(node.bound, fixedCost + relaxed.lowerBound);
+            if (canPrune(node.bound))
+            {
+                return;
+            }
+
+            // reduced cost fixing: taking subset j costs at least bound + rc_j, and leaving it out at least bound - rc_j
+            relaxation.reducedCosts(relaxed.multipliers, reducedCosts);
+            double relaxedBound = fixedCost + relaxed.lowerBound;
+            for (int subset = 0; subset < m_SubsetCount; ++subset)
+            {
+                if (node.fixedSubsets[subset] != 0)
+                {
+                    continue;
+                }
+                if (reducedCosts[subset] >= 0.0 && canPrune(relaxedBound + reducedCosts[subset]))
+                {
+                    node.fixedSubsets[subset] = -1;
+                }
+                else if (reducedCosts[subset] < 0.0 && canPrune(relaxedBound - reducedCosts[subset]))
+                {
+                    node.fixedSubsets[subset] = 1;
+                    fixedCost += m_Costs[subset];
+                    solution.push_back(subset);
+                    for (Index element : m_SubsetElements[subset])
+                    {
+                        coverage[element] += 1;
+                    }
+                }
+            }
+            if (!isCoverable())
+            {
+                return;
+            }
+
+            // the heuristic completes the fixed subsets, so copy what branching still needs
+            std::vector<int> fixedCoverage = coverage;
+            greedyHeuristic(node.fixedSubsets, coverage, solution);
+            int solutionCost = 0;
+            for (int subset : solution)
+            {
+                solutionCost += m_Costs[subset];
+            }
+            offerIncumbent(solution, solutionCost);
+            if (canPrune(node.bound))
+            {
+                return;
+            }
+
+            // branch on the free subset of lowest reduced cost of the uncovered element with the fewest free subsets
+            int branchElement = -1;
+            size_t branchElementOptions = std::numeric_limits<size_t>::max();
+            for (int element = 0; element < m_ElementCount; ++element)
+            {
+                if (fixedCoverage[element] > 0)
+                {
+                    continue;
+                }
+                size_t options = std::count_if(m_Relations[element].begin(), m_Relations[element].end(),
+                    [&node](int subset) { return node.fixedSubsets[subset] == 0; });
+                if (options < branchElementOptions)
+                {
+                    branchElement = element;
+                    branchElementOptions = options;
+                }
+            }
+            if (branchElement < 0)
+            {
+                return; // the fixed subsets already cover everything, and the heuristic has offered them
+            }
+
+            int branchSubset = -1;
+            for (Index subset : m_Relations[branchElement])
+            {
+                if (node.fixedSubsets[subset] == 0 && (branchSubset < 0 || reducedCosts[subset] < reducedCosts[branchSubset]))
+                {
+                    branchSubset = subset;
+                }
+            }
+
+            BranchAndBoundNode excluded{ node.bound, node.fixedSubsets, relaxed.multipliers };
+            excluded.fixedSubsets[branchSubset] = -1;
+            pushNode(worker, std::move(excluded));
+
+            BranchAndBoundNode included{ node.bound, std::move(node.fixedSubsets), std::move(relaxed.multipliers) };
+            included.fixedSubsets[branchSubset] = 1;
+            pushNode(worker, std::move(included));
+        }
+
+    public:
+        BranchAndBoundSearch(
+            const BasicScpInstance<Traits> &instance,
+            long maxRuntime,
+            long maxNodes,
+            int workerCount,
+            const BasicScpSolution<Index> &initialSolution,
+            IncumbentBoard *board)
+            : m_ElementCount(instance.elementCount()), m_SubsetCount(instance.subsetCount()), m_Costs(instance.costs()),
+            m_Relations(instance.relations()), m_SubsetElements(instance.subsetElements()),
+            m_Deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(maxRuntime)), m_MaxNodes(maxNodes),
+            m_Queues(workerCount), m_IncumbentCost(initialSolution.cost()), m_Incumbent(initialSolution.subsets().begin(), initialSolution.subsets().end()),
+            m_Board(board)
+        {
+            m_Queues[0].nodes.push({ 0.0, std::vector<signed char>(m_SubsetCount, 0), {} });
+        }
+
+        void work(int worker)
+        {
+            LagrangianRelaxation<Traits> relaxation(m_ElementCount, m_Costs, m_SubsetElements);
+            std::vector<double> reducedCosts;
+            BranchAndBoundNode node;
+            while (true)
+            {
+                m_BusyWorkers += 1;
+                if (!takeNode(worker, node))
+                {
+                    m_BusyWorkers -= 1;
+                    if (m_BusyWorkers.load() == 0 && !hasQueuedNodes())
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                adoptBoardIncumbent();
+                if (m_Stopped.load(std::memory_order_relaxed))
+                {
+                    dropUnexplored(node.bound);
+                }
+                else if (!canPrune(node.bound))
+                {
+                    long nodeCount = ++m_NodeCount;
+                    if (std::chrono::steady_clock::now() >= m_Deadline || (m_MaxNodes > 0 && nodeCount > m_MaxNodes))
+                    {
+                        m_NodeCount -= 1;
+                        m_Stopped = true;
+                        dropUnexplored(node.bound);
+                    }
+                    else
+                    {
+                        exploreNode(worker, relaxation, node, reducedCosts);
+                    }
+                }
+                m_BusyWorkers -= 1;
+            }
+        }
+
+        ScpExactResult result()
+        {
+            ScpExactResult result;
+            result.solution = { m_IncumbentCost.load(), m_Incumbent.size(), std::unordered_set<int>(m_Incumbent.begin(), m_Incumbent.end()) };
+            result.nodeCount = m_NodeCount.load();
+
+            double lowerBound = std::min<double>(m_UnexploredBound, result.solution.cost);
+            result.lowerBound = static_cast<int>(std::ceil(lowerBound - EPSILON));
+            result.gap = result.solution.cost > 0 ? static_cast<double>(result.solution.cost - result.lowerBound) / result.solution.cost : 0.0;
+            return result;
+        }
+    };
+
+    template<typename Traits>
+    ScpExactResult BasicScp<Traits>::branchAndBound(long maxRuntime, long maxNodes, int threadCount)
+    {
+        constexpr int INCUMBENT_GRASP_ITERATIONS = 20;
+        constexpr int INCUMBENT_GRASP_K = 5;
+
+        m_Stats = {};
+        ScpSolution initialSolution = graspInternal(INCUMBENT_GRASP_ITERATIONS, std::min(INCUMBENT_GRASP_K, m_Instance->subsetCount() - 1));
+        keepBestInitialSolution(initialSolution);
+        publishToBoard(initialSolution);
+
+        threadCount = std::max(threadCount, 1);
+        BranchAndBoundSearch<Traits> search(*m_Instance, maxRuntime, maxNodes, threadCount, initialSolution, m_Board);
+        {
+            // a worker that only starts once the others are done finds nothing left and returns
+            TaskGroup workers(m_Executor ? *m_Executor : Executor::global());
+            for (int worker = 1; worker < threadCount; ++worker)
+            {
+                workers.spawn([&search, worker]() { search.work(worker); });
+            }
+            search.work(0);
+            workers.wait();
+        }
+
+        ScpExactResult result = search.result();
+        HE_STATS_ADD(m_Stats.generations, result.nodeCount);
+        return result;
+    }
+
+    template ScpExactResult BasicScp<ScpTraitsU16>::branchAndBound(long, long, int);
+    template ScpExactResult BasicScp<ScpTraitsU16Wide>::branchAndBound(long, long, int);
+    template ScpExactResult BasicScp<ScpTraitsU16Unicost>::branchAndBound(long, long, int);
+    template ScpExactResult BasicScp<ScpTraitsU32>::branchAndBound(long, long, int);
+    template ScpExactResult BasicScp<ScpTraitsU32Wide>::branchAndBound(long, long, int);
+    template ScpExactResult BasicScp<ScpTraitsU32Unicost>::branchAndBound(long, long, int);
+
+}
@@ -0,0 +1,248 @@
+#include "ScpInstance.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Heuro
+{
+
+    template<typename Traits>
+    BasicScpInstance<Traits>::BasicScpInstance(
+        int elementCount,
+        int subsetCount,
+        const std::vector<int> &costs,
+        const std::vector<std::unordered_set<int>> &relations)
+        : m_ElementCount(elementCount), m_SubsetCount(subsetCount), m_Costs(costs), m_Relations(elementCount), m_SubsetElements(subsetCount)
+    {
+        for (int element = 0; element < m_ElementCount; ++element)
+        {
+            m_Relations[element].assign(relations[element].begin(), relations[element].end());
+            std::sort(m_Relations[element].begin(), m_Relations[element].end());
+            for (Index subset : m_Relations[element])
+            {
+                m_SubsetElements[subset].push_back(static_cast<Index>(element));
+            }
+        }
+        // elements are visited in increasing order, so every subset's list comes out sorted
+        updateDenseCoverage();
+        updateCandidateLists();
+    }
+
+    template<typename Traits>
+    size_t BasicScpInstance<Traits>::bytes() const
+    {
+        size_t bytes = 0;
+        if constexpr (!Traits::UNICOST)
+        {
+            bytes += m_Costs.size() * sizeof(typename Traits::Cost);
+        }
+        for (const std::vector<Index> &relation : m_Relations)
+        {
+            bytes += relation.capacity() * sizeof(Index);
+        }
+        for (const std::vector<Index> &elements : m_SubsetElements)
+        {
+            bytes += elements.capacity() * sizeof(Index);
+        }
+        for (const std::vector<Index> &candidates : m_CandidateLists)
+        {
+            bytes += candidates.capacity() * sizeof(Index);
+        }
+        bytes += (m_Relations.capacity() + m_SubsetElements.capacity() + m_CandidateLists.capacity()) * sizeof(std::vector<Index>);
+        return bytes + (m_DenseCoverage ? m_DenseCoverage->bytes() : 0);
+    }
+
+    template<typename Index>
+    static void insertSorted(std::vector<Index> &values, int value)
+    {
+        auto position = std::lower_bound(values.begin(), values.end(), static_cast<Index>(value));
+        if (position == values.end() || *position != static_cast<Index>(value))
+        {
+            values.insert(position, static_cast<Index>(value));
+        }
+    }
+
+    template<typename Traits>
+    bool BasicScpInstance<Traits>::leavesUncoverable(const ScpEdits &edits) const
+    {
+        int subsetCount = m_SubsetCount + static_cast<int>(edits.addedColumns.size());
+        std::vector<char> isRemoved(subsetCount, 0);
+        for (int subset : edits.removedColumns)
+        {
+            isRemoved[subset] = 1;
+        }
+
+        // elements gaining a subset that is not removed
+        std::vector<char> isCovered(m_ElementCount + edits.addedRows.size(), 0);
+        for (size_t i = 0; i < edits.addedColumns.size(); ++i)
+        {
+            if (!isRemoved[m_SubsetCount + i])
+            {
+                for (int element : edits.addedColumns[i].elements)
+                {
+                    isCovered[element] = 1;
+                }
+            }
+        }
+        for (size_t i = 0; i < edits.addedRows.size(); ++i)
+        {
+            const std::vector<int> &row = edits.addedRows[i];
+            if (std::any_of(row.begin(), row.end(), [&isRemoved](int subset) { return !isRemoved[subset]; }))
+            {
+                isCovered[m_ElementCount + i] = 1;
+            }
+        }
+        for (size_t i = 0; i < edits.addedRows.size(); ++i)
+        {
+            if (!isCovered[m_ElementCount + i])
+            {
+                return true;
+            }
+        }
+
+        // existing elements only lose subsets through removals
+        for (int subset : edits.removedColumns)
+        {
+            if (subset >= m_SubsetCount)
+            {
+                continue;
+            }
+            for (Index element : m_SubsetElements[subset])
+            {
+                const std::vector<Index> &relation = m_Relations[element];
+                bool isLeft = isCovered[element] || std::any_of(relation.begin(), relation.end(), [&isRemoved](Index other) { return !isRemoved[other]; });
+                if (!isLeft)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    template<typename Traits>
+    void BasicScpInstance<Traits>::applyEdits(const ScpEdits &edits)
+    {
+        int elementCount = m_ElementCount + static_cast<int>(edits.addedRows.size());
+        int subsetCount = m_SubsetCount + static_cast<int>(edits.addedColumns.size());
+        m_Relations.resize(elementCount);
+        m_SubsetElements.resize(subsetCount);
+        for (size_t i = 0; i < edits.addedColumns.size(); ++i)
+        {
+            int subset = m_SubsetCount + static_cast<int>(i);
+            m_Costs.push_back(edits.addedColumns[i].cost);
+            for (int element : edits.addedColumns[i].elements)
+            {
+                insertSorted(m_SubsetElements[subset], element);
+                insertSorted(m_Relations[element], subset);
+            }
+        }
+        for (size_t i = 0; i < edits.addedRows.size(); ++i)
+        {
+            int element = m_ElementCount + static_cast<int>(i);
+            for (int subset : edits.addedRows[i])
+            {
+                insertSorted(m_Relations[element], subset);
+                insertSorted(m_SubsetElements[subset], element);
+            }
+        }
+        for (const auto &[subset, cost] : edits.costChanges)
+        {
+            m_Costs.set(subset, cost);
+        }
+        for (int subset : edits.removedColumns)
+        {
+            for (Index element : m_SubsetElements[subset])
+            {
+                std::vector<Index> &relation = m_Relations[element];
+                relation.erase(std::lower_bound(relation.begin(), relation.end(), static_cast<Index>(subset)));
+            }
+            m_SubsetElements[subset].clear();
+        }
+
+        m_ElementCount = elementCount;
+        m_SubsetCount = subsetCount;
+        updateDenseCoverage();
+        updateCandidateLists();
+    }
+
+    template<typename Traits>
+    CoverageMatrix BasicScpInstance<Traits>::makeDenseCoverage(CoverageMatrix::Kernel kernel) const
+    {
+        CoverageMatrix matrix(m_ElementCount, m_SubsetCount, kernel);
+        for (int element = 0; element < m_ElementCount; ++element)
+        {
+            for (Index subset : m_Relations[element])
+            {
+                matrix.set(element, subset);
+            }
+        }
+        for (int subset = 0; subset < m_SubsetCount; ++subset)
+        {
+            matrix.setCost(subset, m_Costs[subset]);
+        }
+        return matrix;
+    }
+
+    template<typename Traits>
+    void BasicScpInstance<Traits>::updateDenseCoverage()
+    {
+        m_DenseCoverage.reset();
+        if (CoverageMatrix::isWorthwhile(m_ElementCount, m_SubsetCount))
+        {
+            m_DenseCoverage = makeDenseCoverage(CoverageMatrix::bestKernel());
+        }
+    }
+
+    template<typename Traits>
+    void BasicScpInstance<Traits>::updateCandidateLists()
+    {
+        auto isBetter = [this](Index a, Index b)
+        {
+            int costA = m_Costs[a];
+            int costB = m_Costs[b];
+            return costA != costB ? costA < costB : m_SubsetElements[a].size() > m_SubsetElements[b].size();
+        };
+
+        m_CandidateLists.resize(m_ElementCount);
+        for (int element = 0; element < m_ElementCount; ++element)
+        {
+            const std::vector<Index> &relation = m_Relations[element];
+            std::vector<Index> &candidates = m_CandidateLists[element];
+            size_t size = std::min(relation.size(), CANDIDATE_LIST_SIZE);
+            candidates.resize(size);
+            std::partial_sort_copy(relation.begin(), relation.end(), candidates.begin(), candidates.end(), isBetter);
+        }
+    }
+
+    std::shared_ptr<const ScpInstance> ScpInstance::create(const ScpInput &input)
+    {
+        bool isUnicost = std::all_of(input.costs.begin(), input.costs.end(), [](int cost) { return cost == 1; });
+        bool hasNarrowCosts = std::all_of(input.costs.begin(), input.costs.end(),
+            [](int cost) { return cost >= 0 && cost <= std::numeric_limits<uint16_t>::max(); });
+
+        auto build = [&input](auto traits) -> std::shared_ptr<const ScpInstance>
+        {
+            using Traits = decltype(traits);
+            return std::make_shared<BasicScpInstance<Traits>>(input.elementCount, input.subsetCount, input.costs, input.relations);
+        };
+
+        if (ScpTraitsU16::fitsSize(input.elementCount, input.subsetCount))
+        {
+            if (isUnicost) return build(ScpTraitsU16Unicost{});
+            if (hasNarrowCosts) return build(ScpTraitsU16{});
+            return build(ScpTraitsU16Wide{});
+        }
+        if (isUnicost) return build(ScpTraitsU32Unicost{});
+        if (hasNarrowCosts) return build(ScpTraitsU32{});
+        return build(ScpTraitsU32Wide{});
+    }
+
+    template class BasicScpInstance<ScpTraitsU16>;
+    template class BasicScpInstance<ScpTraitsU16Wide>;
+    template class BasicScpInstance<ScpTraitsU16Unicost>;
+    template class BasicScpInstance<ScpTraitsU32>;
+    template class BasicScpInstance<ScpTraitsU32Wide>;
+    template class BasicScpInstance<ScpTraitsU32Unicost>;
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "util/CoverageMatrix.hpp"
+#include "util/Data.hpp"
+#include "util/ScpEdits.hpp"
+#include "util/ScpTraits.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Heuro
+{
+
+    template<typename Traits>
+    class BasicScp;
+
+    /**
+     * @brief An SCP instance as the solvers read it. It never changes once built, and every solver created from it (see
+     * ScpSolver::create) holds it by reference count, so any number of solvers on any threads share a single read-only copy.
+     * Whatever a run changes lives in the solver instead.
+     * Each implementation (see BasicScpInstance) stores the instance in the narrowest representation it fits in, and
+     * create() picks the right one.
+     */
+    class ScpInstance
+    {
+    public:
+        virtual ~ScpInstance() = default;
+
+        /**
+         * @brief Builds the instance with 16-bit indices when both dimensions fit, costs stored in 16 bits when they fit, and
+         * no costs at all when every subset costs 1.
+         */
+        static std::shared_ptr<const ScpInstance> create(const ScpInput &input);
+
+        /**
+         * @brief The name of the representation, e.g. "u16/u16" for 16-bit indices and costs.
+         */
+        virtual std::string representation() const = 0;
+
+        virtual int elementCount() const = 0;
+        virtual int subsetCount() const = 0;
+
+        /**
+         * @brief The memory the instance takes, roughly: its coverage indexes, candidate lists, costs and dense coverage matrix.
+         */
+        virtual size_t bytes() const = 0;
+    };
+
+    template<typename Traits>
+    class BasicScpInstance final : public ScpInstance
+    {
+        friend class BasicScp<Traits>; // Edits the instance when it is the only solver holding it
+        friend class ScpBenchmark; // heuro_bench times the kernels without the dense coverage too
+
+    private:
+        using Index = typename Traits::Index;
+
+        int m_ElementCount = 0; // m
+        int m_SubsetCount = 0; // n
+        CostTable<typename Traits::Cost> m_Costs; // Cost of each subset
+        std::vector<std::vector<Index>> m_Relations; // Relations between each element and the subsets that contain it (e.g index 1: 2, 4 means subsets 2 and 4 contain element 1), sorted
+        std::vector<std::vector<Index>> m_SubsetElements; // Inverse of m_Relations: the elements contained by each subset, sorted
+        std::optional<CoverageMatrix> m_DenseCoverage; // Dense copy of m_Relations for bitset solutions, when worth it
+        std::vector<std::vector<Index>> m_CandidateLists; // The CANDIDATE_LIST_SIZE cheapest subsets of each element, cheapest first
+
+        /**
+         * @brief Rebuilds the candidate lists from the relations and costs.
+         */
+        void updateCandidateLists();
+
+        /**
+         * @brief Keeps a dense copy of the relations if CoverageMatrix::isWorthwhile for the instance, and drops it otherwise.
+         */
+        void updateDenseCoverage();
+
+        /**
+         * @brief Applies edits that are valid, fit the representation and leave every element in some subset.
+         */
+        void applyEdits(const ScpEdits &edits);
+
+    public:
+        static constexpr size_t CANDIDATE_LIST_SIZE = 8;
+
+        BasicScpInstance(int elementCount, int subsetCount, const std::vector<int> &costs, const std::vector<std::unordered_set<int>> &relations);
+
+        std::string representation() const override { return Traits::name(); }
+        int elementCount() const override { return m_ElementCount; }
+        int subsetCount() const override { return m_SubsetCount; }
+        size_t bytes() const override;
+
+        const CostTable<typename Traits::Cost> &costs() const { return m_Costs; }
+        const std::vector<std::vector<Index>> &relations() const { return m_Relations; }
+        const std::vector<std::vector<Index>> &subsetElements() const { return m_SubsetElements; }
+        const std::optional<CoverageMatrix> &denseCoverage() const { return m_DenseCoverage; }
+
+        /**
+         * @brief The cheapest subsets containing each element, ties going to the larger subset, so the moves that have to
+         * cover an element only look at a few subsets of its relation.
+         */
+        const std::vector<std::vector<Index>> &candidateLists() const { return m_CandidateLists; }
+
+        /**
+         * @brief Builds the dense copy of the relations, with the costs, for the given kernel.
+         */
+        CoverageMatrix makeDenseCoverage(CoverageMatrix::Kernel kernel) const;
+
+        /**
+         * @brief Whether applying the edits leaves some element in no subset. The edits must be valid.
+         */
+        bool leavesUncoverable(const ScpEdits &edits) const;
+    };
+
+    extern template class BasicScpInstance<ScpTraitsU16>;
+    extern template class BasicScpInstance<ScpTraitsU16Wide>;
+    extern template class BasicScpInstance<ScpTraitsU16Unicost>;
+    extern template class BasicScpInstance<ScpTraitsU32>;
+    extern template class BasicScpInstance<ScpTraitsU32Wide>;
+    extern template class BasicScpInstance<ScpTraitsU32Unicost>;
+
+}
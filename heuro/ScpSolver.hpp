@@ -0,0 +1,268 @@
+#pragma once
+
+#include "ScpInstance.hpp"
+
+#include "util/Data.hpp"
+#include "util/EvaluationCache.hpp"
+#include "util/Executor.hpp"
+#include "util/ScpEdits.hpp"
+#include "util/ScratchArena.hpp"
+
+#include "debug/SearchStats.hpp"
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace Heuro
+{
+
+    class ConvergenceTrace;
+    class IncumbentBoard;
+
+    /**
+     * @brief The algorithms of heuro over a single SCP instance. Each implementation (see BasicScp) reads the instance in
+     * the narrowest representation it fits in, and create() picks the right one.
+     * A solver holds the state of its runs, and shares the instance (see ScpInstance) with every other solver created from
+     * it. A solver runs one algorithm at a time, but solvers of the same instance may run at once on different threads.
+     */
+    class ScpSolver
+    {
+    public:
+        virtual ~ScpSolver() = default;
+
+        /**
+         * @brief Builds the solver specialized for the given instance: 16-bit indices when both dimensions fit, costs stored in
+         * 16 bits when they fit, and no costs at all when every subset costs 1.
+         *
+         * @param scratchUpstream The resource from which the solver's scratch arena takes its memory when it needs to grow.
+         */
+        static std::unique_ptr<ScpSolver> create(const ScpInput &input, std::pmr::memory_resource *scratchUpstream = std::pmr::get_default_resource());
+
+        /**
+         * @brief Builds a solver that shares the given instance, in the representation of the instance.
+         *
+         * @param scratchUpstream The resource from which the solver's scratch arena takes its memory when it needs to grow.
+         */
+        static std::unique_ptr<ScpSolver> create(std::shared_ptr<const ScpInstance> instance, std::pmr::memory_resource *scratchUpstream = std::pmr::get_default_resource());
+
+        /**
+         * @brief The name of the representation used by the solver, e.g. "u16/u16" for 16-bit indices and costs.
+         */
+        virtual std::string representation() const = 0;
+
+        /**
+         * @brief The instance the solver reads, to create more solvers that share it. Once the solver applies edits, it
+         * reads an edited copy, unless it held the only reference.
+         */
+        virtual std::shared_ptr<const ScpInstance> instance() const = 0;
+
+        /**
+         * @brief Reports how much memory the scratch arena has taken from its upstream resource since the last reset of the stats.
+         */
+        virtual const MemoryStats &scratchMemoryStats() const = 0;
+        virtual void resetScratchMemoryStats() = 0;
+
+        /**
+         * @brief The search counters of the last algorithm run. They stay at zero unless the library is built with HE_STATS.
+         */
+        virtual const SearchStats &lastRunStats() const = 0;
+
+        /**
+         * @brief Streams the convergence of every following run to the given trace, or stops doing so if given nullptr.
+         * The caller labels each run with ConvergenceTrace::beginRun and keeps ownership of the trace.
+         */
+        virtual void setConvergenceTrace(ConvergenceTrace *trace) = 0;
+
+        /**
+         * @brief Makes the solver look up and store its from-scratch evaluations in the given cache, which may be shared with
+         * other solvers of the same instance on other threads. Each solver creates its own cache on first use if none is set.
+         */
+        virtual void setEvaluationCache(std::shared_ptr<EvaluationCache> cache) = 0;
+        virtual const std::shared_ptr<EvaluationCache> &evaluationCache() const = 0;
+
+        /**
+         * @brief Runs the parallel work of every following run on the given executor, which several solvers may share, or
+         * on the calling thread alone if given nullptr. Only branchAndBound falls back to Executor::global() instead, to run
+         * its workers. The caller keeps ownership of the executor.
+         */
+        virtual void setExecutor(Executor *executor) = 0;
+
+        /**
+         * @brief Warm starts every following run from the given solutions, e.g. read with ScpSolutionFile. SA and VNS start from
+         * the best of them instead of a greedy construction, BLGA takes it as its leader and seeds its population with all
+         * of them, the core problem starts from it, and the other algorithms return it when they do not find a better one.
+         * Solutions that leave elements uncovered are completed with the cheapest subset of each. An empty list goes back
+         * to cold starts.
+         *
+         * @throws std::invalid_argument If a solution selects a subset the instance does not have.
+         */
+        virtual void setInitialSolutions(const std::vector<ScpResult> &solutions) = 0;
+
+        /**
+         * @brief Makes every following run cooperate with the other solvers and processes attached to the given board (see
+         * IncumbentBoard), or stops doing so if given nullptr. The board must have been created for the solver's instance.
+         * Every algorithm publishes the solutions that beat the board's. SA, VNS and BLGA also restart from the board's
+         * solution whenever it beats the best of their run, the core problem starts its next round from it, and branch and
+         * bound takes it as its incumbent to prune against. Applying edits detaches the board, since the instance no longer
+         * matches it. The caller keeps ownership of the board.
+         */
+        virtual void setIncumbentBoard(IncumbentBoard *board) = 0;
+
+        /**
+         * @brief Makes every following SA, VNS (also within reoptimize) and BLGA run save its state to the given file about
+         * every intervalMillis, or stops doing so if given an empty path. The file is written from a background thread and
+         * replaced atomically, so it always holds a whole checkpoint. A run that finds a checkpoint of the same algorithm and
+         * parameters in the file continues from it instead of starting over: from the same solutions, SA temperature, BLGA
+         * population, random state and elapsed runtime. The file is removed once a run ends.
+         * The SA cooling schedule is not part of the checkpoint, so resume with the same one.
+         *
+         * The runs throw std::runtime_error if the file holds a checkpoint of another run or instance, or can not be written.
+         */
+        virtual void setCheckpoint(const std::string &path, long intervalMillis) = 0;
+
+        /**
+         * @brief Changes the instance (see ScpEdits), keeping the coverage indexes consistent. The instance is edited in place
+         * when no other solver shares it, and copied first otherwise, so the others keep solving it as it was. Initial
+         * solutions stay set, while the evaluation cache and the incumbent board are dropped since they no longer hold.
+         *
+         * @return Whether the edits were applied. They are not when the edited instance does not fit the representation of the
+         * solver, e.g. a cost other than 1 on a unicost solver; apply them to the ScpInput and create() a new solver then.
+         * @throws std::invalid_argument If the edits are invalid, or leave an element in no subset. Nothing changes then.
+         */
+        virtual bool applyEdits(const ScpEdits &edits) = 0;
+
+        /**
+         * @brief Re-solves the instance after some edits, starting from a solution of the instance before them, so that small
+         * changes take a fraction of a full run. Subsets that were removed are dropped from the solution, every element left
+         * uncovered gets the cheapest subset that contains it, the subsets made redundant are dropped, most expensive first,
+         * and VNS improves the result for the given time.
+         *
+         * @param previousSolution A solution of the instance before the edits.
+         * @param maxRuntime The amount of time in milliseconds for which the local search is allowed to run.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult reoptimize(const ScpResult &previousSolution, long maxRuntime) = 0;
+
+        /**
+         * @brief Calculates a solution using a simple greedy algorithm, which always picks the subset with the lowest cost per
+         * element it would newly cover.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult constructive() = 0;
+
+        /**
+         * @brief Calculates several solutions using a randomized greedy algorithm, and later chooses the best one.
+         * During each iteration, it chooses a subset at random from the k subsets with the lowest cost per element they would
+         * newly cover, among those that still cover some element.
+         *
+         * @param maxSolCount The maximum number of iterations the algorithm is allowed.
+         * @param k The size of the RCL from which an element will be chosen at random.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult grasp(int maxSolCount, int k) = 0;
+
+        /**
+         * @brief Calculates several solutions using a randomized greedy algorithm and noise, and later chooses the best one.
+         * During each iteration, it chooses a subset at random from the k subsets with the lowest cost per element they would
+         * newly cover, among those that still cover some element.
+         * Also, every cost is modified by +/- the noise factor.
+         *
+         * @param maxSolCount The maximum number of iterations the algorithm is allowed.
+         * @param k The size of the RCL from which an element will be chosen at random.
+         * @param rho The noise factor.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult graspWithNoise(int maxSolCount, int k, int rho) = 0;
+
+        /**
+         * @brief Tries to find an as-close as possible optimal solution by using a local search meta-heuristic capable of escaping local optima.
+         * It allows hill-climbing moves in hopes of finding the global optimum.
+         * It simulates the process of physical annealing with solids, in which a crystalline solid is heated and then allowed to cool very slowly
+         * until it achieves its most regular possible crystal lattice configuration, and thus is free of crystal defects.
+         *
+         * (Based on the algorithm proposed in 'Handbook of Metaheuristics', by Michel Gendreau and Jean-Yves Potvin).
+         *
+         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         * @param initTemp The initial temperature of the simulation.
+         * @param iterPerTemp The number of iterations executed at each temperature.
+         * @param tempCoolingSchedule The cooling function. It accepts the initial one and the current iteration number, and returns the new temp..
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult simulatedAnnealing(long maxRuntime, double initTemp, int iterPerTemp, const std::function<double(double, int)> &tempCoolingSchedule) = 0;
+
+        /**
+         * @brief Tries to find an as-close as possible optimal solution by using a variable neighbourhood search method.
+         * In it, a neighbour is generated and accepted in case it improves on the current solution.
+         * Otherwise, the search continues in another neighbourhood (max. 4 different neighbourhoods: random swaps, sequential
+         * removals, the best swap, then 2-flip and 3-flip moves drawn through the candidate lists of the instance).
+         *
+         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult vns(long maxRuntime) = 0;
+
+        /**
+         * @brief Calculates a solution using a binary-coded local genetic algorithm (BLGA), a hybrid steady-state genetic algorithm that
+         * combines the speed and power of a genetic algorithm with the precision of a local search procedure. It makes use of
+         * positive assortative mating to select parents near the current best solution, random-parent uniform crossover to create an offspring
+         * relatively near the current search space, and restricted tournament selection (RTS) to improve the quality of the population.
+         *
+         * (Based on the algorithm proposed in 'Local Search Based on Genetic Algorithms', by Carlos Garcia-Martinez and Manuel Lozano).
+         *
+         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         * @param matesCount The number of mates selected from the population using positive assortative mating.
+         * @param geneCopyProbability The probability of a gene from the best solution to be carried over to its offspring.
+         * @param rtsSampleSize The number of randomly selected individuals from the population for the RTS procedure.
+         *
+         * @return The cost of the found solution, as well as the chosen subsets count and their IDs.
+         */
+        virtual ScpResult blga(long maxRuntime, int populationSize, int matesCount, double geneCopyProbability, int rtsSampleSize) = 0;
+
+        /**
+         * @brief Solves large instances by running another algorithm only on a core problem: a small subset of the columns that
+         * are most likely to appear in good solutions, so that each of its steps depends on the size of the core instead of n.
+         * The columns are priced by their Lagrangian reduced costs, and for every element the columnsPerRow cheapest ones that
+         * contain it form the core, together with the columns of the best solution so far. After each round, the multipliers
+         * are improved by subgradient ascent on the core, the full column set is priced again and the core is rebuilt.
+         *
+         * (Based on the core problem approach proposed in 'A Heuristic Method for the Set Covering Problem', by Alberto Caprara,
+         * Matteo Fischetti and Paolo Toth).
+         *
+         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         * @param columnsPerRow The amount of columns taken into the core for each element.
+         * @param pricingRounds The amount of times the core is built and solved. The runtime is split evenly among them.
+         * @param algorithm Solves the core problem, given a solver for it and the runtime of the round.
+         *
+         * @return The best solution found in any round, with the subset IDs of this (full) instance.
+         */
+        virtual ScpResult coreProblem(long maxRuntime, int columnsPerRow, int pricingRounds, const std::function<ScpResult(ScpSolver &core, long roundRuntime)> &algorithm) = 0;
+
+        /**
+         * @brief Solves the instance exactly by branch and bound, meant for small instances (scp4* sized).
+         * Every node is bounded by the Lagrangian relaxation of its subproblem, warm started from its parent's multipliers, and
+         * the free subsets whose reduced cost proves them useless (or indispensable) are fixed before branching. Nodes are explored
+         * best bound first, and each one also runs a greedy heuristic to improve the incumbent, which starts from a GRASP solution.
+         * With several threads, each one explores its own queue of nodes and steals the best node of another queue once its own
+         * runs dry.
+         *
+         * @param maxRuntime The amount of time in milliseconds for which the algorithm is allowed to run.
+         * @param maxNodes The maximum amount of nodes explored, or 0 for no limit.
+         * @param threadCount The amount of workers exploring nodes, 1 to explore them on the calling thread only. The other
+         * workers run on the solver's executor, or on Executor::global() if it has none, and never exceed its concurrency.
+         *
+         * @return The best solution found and the lower bound proven for the instance. The solution is optimal if the search
+         * finished within its limits.
+         */
+        virtual ScpExactResult branchAndBound(long maxRuntime, long maxNodes = 0, int threadCount = 1) = 0;
+    };
+
+}
@@ -0,0 +1,140 @@
+#include "ConvergenceTrace.hpp"
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace Heuro
+{
+
+    static long checkedSampleInterval(long sampleInterval)
+    {
+        if (sampleInterval < 1)
+        {
+            throw std::invalid_argument("Convergence trace sample interval must be at least 1, got " + std::to_string(sampleInterval));
+        }
+        return sampleInterval;
+    }
+
+    // the run label, quoted when it holds a separator, a quote or a line break
+    static std::string csvField(const std::string &text)
+    {
+        if (text.find_first_of(",\"\r\n") == std::string::npos)
+        {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            quoted += c == '"' ? "\"\"" : std::string(1, c);
+        }
+        return quoted + '"';
+    }
+
+    ConvergenceTrace::ConvergenceTrace(const std::string &filepath, long sampleInterval, size_t batchCapacity, size_t maxPendingBatches)
+        : m_BatchCapacity(batchCapacity), m_MaxPendingBatches(maxPendingBatches), m_SampleInterval(checkedSampleInterval(sampleInterval))
+    {
+        // opened only once the arguments are checked, so a rejected trace leaves the file alone
+        m_Output.open(filepath);
+        if (!m_Output.is_open())
+        {
+            std::cerr << "ConvergenceTrace could not open output file " << filepath << std::endl;
+        }
+
+        m_Output << "run,time_ms,iteration,current_cost,best_cost\n";
+        m_Current.points.reserve(m_BatchCapacity);
+        m_Writer = std::thread(&ConvergenceTrace::writerLoop, this);
+    }
+
+    ConvergenceTrace::ConvergenceTrace(long sampleInterval)
+        : m_InMemory(true), m_BatchCapacity(std::numeric_limits<size_t>::max()), m_MaxPendingBatches(0), m_SampleInterval(checkedSampleInterval(sampleInterval))
+    {
+    }
+
+    ConvergenceTrace::~ConvergenceTrace()
+    {
+        if (m_InMemory)
+        {
+            return;
+        }
+
+        submitCurrent();
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_PendingChanged.notify_all();
+        m_Writer.join();
+    }
+
+    void ConvergenceTrace::beginRun(const std::string &label)
+    {
+        if (m_InMemory)
+        {
+            m_Current.points.clear();
+        }
+        submitCurrent();
+        m_Current.runLabel = label;
+        m_LastBestCost = std::numeric_limits<int>::max();
+        m_RunStart = std::chrono::steady_clock::now();
+    }
+
+    void ConvergenceTrace::flush()
+    {
+        if (m_InMemory)
+        {
+            return;
+        }
+
+        submitCurrent();
+        std::unique_lock lock(m_Mutex);
+        m_PendingChanged.wait(lock, [this] { return m_Pending.empty(); });
+    }
+
+    void ConvergenceTrace::submitCurrent()
+    {
+        if (m_Current.points.empty())
+        {
+            return;
+        }
+
+        Batch next{ m_Current.runLabel, {} };
+        next.points.reserve(m_BatchCapacity);
+        {
+            std::unique_lock lock(m_Mutex);
+            m_PendingChanged.wait(lock, [this] { return m_Pending.size() < m_MaxPendingBatches; });
+            m_Pending.push_back(std::move(m_Current));
+        }
+        m_PendingChanged.notify_all();
+        m_Current = std::move(next);
+    }
+
+    void ConvergenceTrace::writerLoop()
+    {
+        std::unique_lock lock(m_Mutex);
+        while (true)
+        {
+            m_PendingChanged.wait(lock, [this] { return m_Stopping || !m_Pending.empty(); });
+            if (m_Pending.empty())
+            {
+                return; // stopping, and everything has been written
+            }
+
+            Batch batch = std::move(m_Pending.front());
+            lock.unlock();
+
+            std::string runField = csvField(batch.runLabel);
+            for (const ConvergencePoint &point : batch.points)
+            {
+                m_Output << runField << ',' << point.elapsedMillis << ',' << point.iteration << ','
+                         << point.currentCost << ',' << point.bestCost << '\n';
+            }
+            m_Output.flush();
+
+            lock.lock();
+            m_Pending.pop_front(); // popped only once written, so flush() also waits for the batch in progress
+            m_PendingChanged.notify_all();
+        }
+    }
+
+}
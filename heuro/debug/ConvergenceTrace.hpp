@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Heuro
+{
+
+    struct ConvergencePoint
+    {
+        double elapsedMillis;
+        long iteration;
+        int currentCost;
+        int bestCost;
+    };
+
+    /**
+     * @brief Streams the (time, iteration, current cost, best cost) trace of algorithm runs to a CSV file.
+     * Points are appended to a local buffer without locking, and full buffers are handed to a background thread that writes
+     * them, so recording stays cheap inside the hot loops. At most maxPendingBatches buffers wait to be written; past that,
+     * the recording thread blocks until the writer catches up.
+     * A trace must be fed from a single thread at a time.
+     * A trace built without a file keeps the points of its current run in memory instead, for tools that analyse the runs
+     * themselves (see points).
+     */
+    class ConvergenceTrace
+    {
+    private:
+        struct Batch
+        {
+            std::string runLabel;
+            std::vector<ConvergencePoint> points;
+        };
+
+        std::ofstream m_Output;
+        bool m_InMemory = false;
+        size_t m_BatchCapacity;
+        size_t m_MaxPendingBatches;
+        long m_SampleInterval;
+
+        // Producer side
+        Batch m_Current;
+        std::chrono::time_point<std::chrono::steady_clock> m_RunStart;
+        int m_LastBestCost = 0;
+
+        // Shared with the writer
+        std::deque<Batch> m_Pending;
+        bool m_Stopping = false;
+        std::mutex m_Mutex;
+        std::condition_variable m_PendingChanged;
+        std::thread m_Writer;
+
+        void submitCurrent();
+        void writerLoop();
+
+    public:
+        /**
+         * @param filepath The CSV file to write. It is truncated. Run labels are quoted in it when they need to be.
+         * @param sampleInterval Besides every improvement of the best cost, one point is kept every sampleInterval iterations.
+         * @param batchCapacity The amount of points buffered before they are handed to the writer.
+         * @param maxPendingBatches The amount of full buffers that may wait for the writer.
+         *
+         * @throws std::invalid_argument If sampleInterval is below 1.
+         */
+        explicit ConvergenceTrace(const std::string &filepath, long sampleInterval = 1000, size_t batchCapacity = 4096, size_t maxPendingBatches = 4);
+        ~ConvergenceTrace();
+
+        /**
+         * @brief A trace that keeps the points of the current run in memory.
+         *
+         * @throws std::invalid_argument If sampleInterval is below 1.
+         */
+        explicit ConvergenceTrace(long sampleInterval);
+
+        ConvergenceTrace(const ConvergenceTrace &) = delete;
+        ConvergenceTrace &operator=(const ConvergenceTrace &) = delete;
+
+        /**
+         * @brief Starts a new run. Its points are labelled and timed from now on.
+         */
+        void beginRun(const std::string &label);
+
+        void record(long iteration, int currentCost, int bestCost)
+        {
+            if (iteration % m_SampleInterval != 0 && bestCost >= m_LastBestCost)
+            {
+                return;
+            }
+
+            m_LastBestCost = bestCost;
+            double elapsedMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_RunStart).count();
+            m_Current.points.push_back({ elapsedMillis, iteration, currentCost, bestCost });
+            if (m_Current.points.size() >= m_BatchCapacity)
+            {
+                submitCurrent();
+            }
+        }
+
+        /**
+         * @brief Hands the buffered points to the writer and waits until everything has reached the file.
+         */
+        void flush();
+
+        /**
+         * @brief The points of the current run, for a trace kept in memory.
+         */
+        const std::vector<ConvergencePoint> &points() const { return m_Current.points; }
+    };
+
+}
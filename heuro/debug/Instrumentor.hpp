@@ -1,36 +1,179 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
-#include <chrono>
-#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define HE_PROFILE_TSC
+    #include <x86intrin.h>
+#endif
 
 namespace Heuro
 {
 
+    /**
+     * @brief The clock read at each scope boundary: the time stamp counter where there is one, the steady clock ticks
+     * otherwise. Neither is converted when read, the session scales the ticks to nanoseconds once it ends.
+     */
+    struct ProfileClock
+    {
+        static int64_t now()
+        {
+#ifdef HE_PROFILE_TSC
+            return static_cast<int64_t>(__rdtsc());
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+    };
+
     struct ProfileResult
     {
-        std::string name;
-        std::chrono::milliseconds elapsedTime;
+        const char *name; // Must outlive the session, see Instrumentor::internName
+        int64_t startTicks;
+        int64_t elapsedTicks;
     };
 
     struct InstrumentationSession
     {
         std::string name;
+        std::string filepath;
+    };
+
+    /**
+     * @brief Append-only buffer of the profiles recorded by a single thread. The owning thread pushes without locking, and
+     * the session drains it concurrently: each chunk publishes its filled count with release semantics, and a chunk is only
+     * freed once the writer has moved on to the next one.
+     */
+    class ProfileBuffer
+    {
+    private:
+        struct Chunk
+        {
+            static constexpr size_t CAPACITY = 4096;
+
+            std::array<ProfileResult, CAPACITY> results;
+            std::atomic<size_t> count = 0;
+            std::atomic<Chunk *> next = nullptr;
+        };
+
+        uint32_t m_ThreadId;
+        Chunk *m_Tail; // Only touched by the writer
+        Chunk *m_Head; // Only touched by the reader
+        size_t m_ReadIndex = 0;
+
+    public:
+        explicit ProfileBuffer(uint32_t threadId)
+            : m_ThreadId(threadId), m_Tail(new Chunk), m_Head(m_Tail)
+        {
+        }
+
+        ProfileBuffer(const ProfileBuffer &) = delete;
+        ProfileBuffer &operator=(const ProfileBuffer &) = delete;
+
+        ~ProfileBuffer()
+        {
+            while (m_Head)
+            {
+                Chunk *next = m_Head->next.load(std::memory_order_acquire);
+                delete m_Head;
+                m_Head = next;
+            }
+        }
+
+        uint32_t threadId() const { return m_ThreadId; }
+
+        void push(const char *name, int64_t startTicks, int64_t elapsedTicks)
+        {
+            size_t index = m_Tail->count.load(std::memory_order_relaxed);
+            if (index == Chunk::CAPACITY)
+            {
+                grow();
+                index = 0;
+            }
+
+            m_Tail->results[index] = { name, startTicks, elapsedTicks };
+
+            m_Tail->count.store(index + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Calls func with every profile published since the last drain. Must only be called by one thread at a time.
+         * The owning thread keeps pushing meanwhile.
+         */
+        template<typename Func>
+        void drain(Func &&func)
+        {
+            while (true)
+            {
+                size_t count = m_Head->count.load(std::memory_order_acquire);
+                for (; m_ReadIndex < count; ++m_ReadIndex)
+                {
+                    func(m_Head->results[m_ReadIndex]);
+                }
+
+                Chunk *next = m_Head->next.load(std::memory_order_acquire);
+                if (!next)
+                {
+                    return;
+                }
+
+                // the writer fills a chunk completely before linking the next one
+                count = m_Head->count.load(std::memory_order_acquire);
+                for (; m_ReadIndex < count; ++m_ReadIndex)
+                {
+                    func(m_Head->results[m_ReadIndex]);
+                }
+
+                delete m_Head;
+                m_Head = next;
+                m_ReadIndex = 0;
+            }
+        }
+
+    private:
+        // once every CAPACITY pushes, kept apart so push stays small enough to inline
+        void grow()
+        {
+            auto *chunk = new Chunk;
+            m_Tail->next.store(chunk, std::memory_order_release);
+            m_Tail = chunk;
+        }
     };
 
+    /**
+     * @brief Collects scope timings from any thread into per-thread buffers, and writes them as a Chrome trace
+     * (about:tracing / Perfetto JSON) when the session ends.
+     */
     class Instrumentor
     {
     private:
         InstrumentationSession *m_CurrentSession;
-        std::ofstream m_OutputStream;
+        std::atomic<bool> m_Active;
+        std::mutex m_Mutex; // Guards the session and the buffer registry, never taken when recording
+        std::vector<std::unique_ptr<ProfileBuffer>> m_Buffers;
+        std::unordered_set<std::string> m_InternedNames;
+        int64_t m_EpochTicks; // ProfileClock and steady clock at the start of the session, to scale the ticks
+        std::chrono::time_point<std::chrono::steady_clock> m_Epoch;
 
     public:
         Instrumentor(const Instrumentor &) = delete;
         Instrumentor(Instrumentor &&) = delete;
 
         Instrumentor()
-            : m_CurrentSession(nullptr)
+            : m_CurrentSession(nullptr), m_Active(false), m_EpochTicks(ProfileClock::now()), m_Epoch(std::chrono::steady_clock::now())
         {
         }
 
@@ -39,43 +182,57 @@ namespace Heuro
             endSession();
         }
 
-        void beginSession(const std::string &name, const std::string &filepath = "profile.txt")
+        void beginSession(const std::string &name, const std::string &filepath = "profile.json")
         {
+            std::lock_guard lock(m_Mutex);
             if (m_CurrentSession)
             {
                 internalEndSession();
             }
 
-            m_OutputStream.open(filepath);
-
-            if (m_OutputStream.is_open())
+            std::ofstream probe(filepath);
+            if (!probe.is_open())
             {
-                m_CurrentSession = new InstrumentationSession{ name };
-                writeHeader();
+                std::cerr << "Instrumentor could not open output file " << filepath << std::endl;
+                return;
             }
-            else
+
+            // drop whatever was recorded outside of a session
+            for (auto &buffer : m_Buffers)
             {
-                std::cerr << "Instrumentor could not open output file " << filepath << std::endl;
+                buffer->drain([](const ProfileResult &) {});
             }
+
+            m_CurrentSession = new InstrumentationSession{ name, filepath };
+            m_Epoch = std::chrono::steady_clock::now();
+            m_EpochTicks = ProfileClock::now();
+            m_Active.store(true, std::memory_order_release);
         }
 
         void endSession()
         {
+            std::lock_guard lock(m_Mutex);
             internalEndSession();
         }
 
-        void writeProfile(const ProfileResult &result)
+        bool isActive() const
         {
-            std::stringstream output;
+            return m_Active.load(std::memory_order_relaxed);
+        }
 
-            output << std::setprecision(3) << std::fixed;
-            output << result.name << '\t' << result.elapsedTime.count() << "ms" << '\n';
+        void writeProfile(const char *name, int64_t startTicks, int64_t elapsedTicks)
+        {
+            threadBuffer().push(name, startTicks, elapsedTicks);
+        }
 
-            if (m_CurrentSession)
-            {
-                m_OutputStream << output.str();
-                m_OutputStream.flush();
-            }
+        /**
+         * @brief Returns a copy of the name that lives as long as the instrumentor. Profiles only keep a pointer to their name,
+         * so names built at runtime must go through here, while string literals can be used directly.
+         */
+        const char *internName(const std::string &name)
+        {
+            std::lock_guard lock(m_Mutex);
+            return m_InternedNames.insert(name).first->c_str();
         }
 
         static Instrumentor &get()
@@ -85,35 +242,120 @@ namespace Heuro
         }
 
     private:
-        void writeHeader()
+        ProfileBuffer &threadBuffer()
         {
-            m_OutputStream << "PROFILING RESULTS" << '\n';
-            m_OutputStream.flush();
+            // constant-initialized, so reading it needs no guard, unlike a thread_local with a dynamic initializer
+            thread_local ProfileBuffer *buffer = nullptr;
+            if (!buffer)
+            {
+                buffer = registerThread();
+            }
+            return *buffer;
+        }
+
+        ProfileBuffer *registerThread()
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Buffers.push_back(std::make_unique<ProfileBuffer>(static_cast<uint32_t>(m_Buffers.size())));
+            return m_Buffers.back().get();
+        }
+
+        static void writeEscaped(std::ostream &os, const char *text)
+        {
+            for (; *text; ++text)
+            {
+                switch (*text)
+                {
+                    case '"': os << "\\\""; break;
+                    case '\\': os << "\\\\"; break;
+                    case '\t': os << "\\t"; break;
+                    case '\n': os << "\\n"; break;
+                    default: os << *text; break;
+                }
+            }
         }
 
         void internalEndSession()
         {
-            if (m_CurrentSession)
+            if (!m_CurrentSession)
+            {
+                return;
+            }
+            m_Active.store(false, std::memory_order_release);
+
+            // the ticks per nanosecond over the whole session, measured against the steady clock
+            int64_t elapsedTicks = ProfileClock::now() - m_EpochTicks;
+            int64_t elapsedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Epoch).count();
+            double nanosPerTick = elapsedTicks > 0 ? static_cast<double>(elapsedNanos) / static_cast<double>(elapsedTicks) : 1.0;
+            auto toNanos = [nanosPerTick](int64_t ticks) { return static_cast<long long>(static_cast<double>(ticks) * nanosPerTick); };
+
+            std::vector<std::pair<ProfileResult, uint32_t>> results; // profiles and the ID of the thread that recorded them
+            for (auto &buffer : m_Buffers)
             {
-                m_OutputStream.close();
-                delete m_CurrentSession;
-                m_CurrentSession = nullptr;
+                uint32_t threadId = buffer->threadId();
+                buffer->drain([&results, threadId](const ProfileResult &result) { results.emplace_back(result, threadId); });
             }
+            std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) { return a.first.startTicks < b.first.startTicks; });
+
+            std::ofstream outputStream(m_CurrentSession->filepath);
+            outputStream << "{\"otherData\":{\"session\":\"";
+            writeEscaped(outputStream, m_CurrentSession->name.c_str());
+            outputStream << "\"},\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            char timestamp[64];
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const auto &[result, threadId] = results[i];
+                outputStream << (i ? ",\n" : "\n") << "{\"cat\":\"scope\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadId << ",\"name\":\"";
+                writeEscaped(outputStream, result.name);
+                // timestamps are in microseconds from the start of the session, keep the nanoseconds as decimals
+                long long startNanos = toNanos(result.startTicks - m_EpochTicks);
+                long long durationNanos = toNanos(result.elapsedTicks);
+                std::snprintf(timestamp, sizeof(timestamp), "\",\"ts\":%lld.%03lld,\"dur\":%lld.%03lld}",
+                    startNanos / 1000, startNanos % 1000, durationNanos / 1000, durationNanos % 1000);
+                outputStream << timestamp;
+            }
+            outputStream << "\n]}\n";
+
+            delete m_CurrentSession;
+            m_CurrentSession = nullptr;
         }
     };
 
+    /**
+     * @brief Times its scope into the instrumentor, if a session is active when it is created. Each boundary reads the clock
+     * once and nothing else is converted or looked up until the session is written.
+     */
     class InstrumentationTimer
     {
     private:
         const char *m_Name;
-        std::chrono::time_point<std::chrono::steady_clock> m_StartTimePoint;
+        int64_t m_StartTicks;
         bool m_Stopped;
 
     public:
+        /**
+         * @param name The scope name. It is not copied, so it must be a string literal or otherwise outlive the session.
+         */
         explicit InstrumentationTimer(const char *name)
-            : m_Name(name), m_Stopped(false)
+            : m_Name(name), m_StartTicks(0), m_Stopped(!Instrumentor::get().isActive())
+        {
+            if (!m_Stopped)
+            {
+                m_StartTicks = ProfileClock::now();
+            }
+        }
+
+        /**
+         * @param name The scope name, interned so it can be built at runtime.
+         */
+        explicit InstrumentationTimer(const std::string &name)
+            : m_Name(nullptr), m_StartTicks(0), m_Stopped(!Instrumentor::get().isActive())
         {
-            m_StartTimePoint = std::chrono::steady_clock::now();
+            if (!m_Stopped)
+            {
+                m_Name = Instrumentor::get().internName(name);
+                m_StartTicks = ProfileClock::now();
+            }
         }
 
         ~InstrumentationTimer()
@@ -126,13 +368,8 @@ namespace Heuro
 
         void stop()
         {
-            auto endTimePoint = std::chrono::steady_clock::now();
-
-            auto elapsedTime =
-                std::chrono::time_point_cast<std::chrono::milliseconds>(endTimePoint).time_since_epoch()
-                - std::chrono::time_point_cast<std::chrono::milliseconds>(m_StartTimePoint).time_since_epoch();
-
-            Instrumentor::get().writeProfile({ m_Name, elapsedTime });
+            int64_t endTicks = ProfileClock::now();
+            Instrumentor::get().writeProfile(m_Name, m_StartTicks, endTicks - m_StartTicks);
 
             m_Stopped = true;
         }
@@ -140,12 +377,17 @@ namespace Heuro
 
 }
 
+#define HE_CONCAT_INTERNAL(a, b) a##b
+#define HE_CONCAT(a, b) HE_CONCAT_INTERNAL(a, b)
+
 #ifdef HE_PROFILE
     #define HE_PROFILE_BEGIN_SESSION(name, filepath) ::Heuro::Instrumentor::get().beginSession(name, filepath)
     #define HE_PROFILE_END_SESSION() ::Heuro::Instrumentor::get().endSession()
-    #define HE_PROFILE_SCOPE(name) ::Heuro::InstrumentationTimer timer##__LINE__(name)
+    #define HE_PROFILE_SCOPE(name) ::Heuro::InstrumentationTimer HE_CONCAT(timer, __COUNTER__)(name)
+    #define HE_PROFILE_FUNCTION() HE_PROFILE_SCOPE(__func__)
 #else
     #define HE_PROFILE_BEGIN_SESSION(name, filepath)
     #define HE_PROFILE_END_SESSION()
     #define HE_PROFILE_SCOPE(name)
-#endif
\ No newline at end of file
+    #define HE_PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Counters describing how a single algorithm run spent its budget.
+     * They are only updated when the library is built with HE_STATS, otherwise every update compiles to nothing.
+     */
+    struct SearchStats
+    {
+#ifdef HE_STATS
+        static constexpr bool ENABLED = true;
+#else
+        static constexpr bool ENABLED = false;
+#endif
+
+        uint64_t movesProposed = 0; // Neighbours or offspring evaluated
+        uint64_t movesAccepted = 0; // Proposals that replaced the current solution
+        uint64_t movesImproving = 0; // Accepted proposals that strictly lowered the current cost
+        uint64_t feasibilityChecks = 0;
+        uint64_t repairCalls = 0; // Extra attempts needed to turn an infeasible proposal into a feasible one
+        uint64_t generations = 0; // Iterations of the main loop (temperature steps, VNS rounds, BLGA generations)
+        uint64_t restarts = 0; // Solutions built from scratch (greedy randomized constructions)
+        uint64_t cacheLookups = 0; // Evaluations looked up in the evaluation cache
+        uint64_t cacheHits = 0; // Lookups that skipped the evaluation
+        uint64_t duplicatesRejected = 0; // Individuals kept out of the BLGA population because an identical one was already in it
+
+        SearchStats &operator+=(const SearchStats &other)
+        {
+            movesProposed += other.movesProposed;
+            movesAccepted += other.movesAccepted;
+            movesImproving += other.movesImproving;
+            feasibilityChecks += other.feasibilityChecks;
+            repairCalls += other.repairCalls;
+            generations += other.generations;
+            restarts += other.restarts;
+            cacheLookups += other.cacheLookups;
+            cacheHits += other.cacheHits;
+            duplicatesRejected += other.duplicatesRejected;
+            return *this;
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const SearchStats &stats)
+        {
+            os << "proposed: " << stats.movesProposed << " accepted: " << stats.movesAccepted << " improving: " << stats.movesImproving
+               << " feasibilityChecks: " << stats.feasibilityChecks << " repairs: " << stats.repairCalls
+               << " generations: " << stats.generations << " restarts: " << stats.restarts
+               << " cacheHits: " << stats.cacheHits << "/" << stats.cacheLookups << " duplicatesRejected: " << stats.duplicatesRejected;
+            return os;
+        }
+    };
+
+}
+
+#ifdef HE_STATS
+    #define HE_STATS_ADD(counter, amount) ((counter) += (amount))
+#else
+    #define HE_STATS_ADD(counter, amount) ((void)0)
+#endif
+
+#define HE_STATS_INCREMENT(counter) HE_STATS_ADD(counter, 1)
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Dynamically sized bitset backed by 64-bit words, exposing its words so that set bits can be iterated
+     * with count-trailing-zeros instead of testing every position.
+     */
+    class Bitset
+    {
+    public:
+        using Word = uint64_t;
+        static constexpr size_t WORD_BITS = 64;
+
+    private:
+        std::vector<Word> m_Words;
+        size_t m_Size = 0;
+
+    public:
+        Bitset() = default;
+
+        explicit Bitset(size_t size)
+            : m_Words((size + WORD_BITS - 1) / WORD_BITS, 0), m_Size(size)
+        {
+        }
+
+        size_t size() const { return m_Size; }
+        size_t wordCount() const { return m_Words.size(); }
+
+        const std::vector<Word> &words() const { return m_Words; }
+        std::vector<Word> &words() { return m_Words; }
+
+        bool test(size_t pos) const
+        {
+            return (m_Words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+        }
+
+        void set(size_t pos)
+        {
+            m_Words[pos / WORD_BITS] |= Word(1) << (pos % WORD_BITS);
+        }
+
+        void reset(size_t pos)
+        {
+            m_Words[pos / WORD_BITS] &= ~(Word(1) << (pos % WORD_BITS));
+        }
+
+        void reset()
+        {
+            std::fill(m_Words.begin(), m_Words.end(), 0);
+        }
+
+        size_t count() const
+        {
+            size_t total = 0;
+            for (Word word : m_Words)
+            {
+                total += std::popcount(word);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Counts the positions in which both bitsets differ. Both must have the same size.
+         */
+        size_t hammingDistance(const Bitset &other) const
+        {
+            size_t distance = 0;
+            for (size_t i = 0; i < m_Words.size(); ++i)
+            {
+                distance += std::popcount(m_Words[i] ^ other.m_Words[i]);
+            }
+            return distance;
+        }
+
+        /**
+         * @brief Calls func with the index of every set bit, in increasing order.
+         */
+        template<typename Func>
+        void forEachSetBit(Func &&func) const
+        {
+            for (size_t w = 0; w < m_Words.size(); ++w)
+            {
+                Word word = m_Words[w];
+                while (word)
+                {
+                    func(w * WORD_BITS + std::countr_zero(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        bool operator==(const Bitset &other) const = default;
+    };
+
+}
@@ -0,0 +1,230 @@
+#include "Checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace Heuro
+{
+
+    static const char *CHECKPOINT_HEADER = "heuro-checkpoint 1";
+
+    // the rest of the next line after "<name> ", which may be empty
+    static std::string readField(std::istream &is, const std::string &name)
+    {
+        std::string line;
+        if (!std::getline(is, line) || line.compare(0, name.size(), name) != 0 || (line.size() > name.size() && line[name.size()] != ' '))
+        {
+            throw std::runtime_error("Checkpoint is missing its " + name);
+        }
+        return line.size() > name.size() ? line.substr(name.size() + 1) : std::string();
+    }
+
+    template<typename T>
+    static T readNumberField(std::istream &is, const std::string &name)
+    {
+        std::istringstream value(readField(is, name));
+        T number;
+        if (!(value >> number))
+        {
+            throw std::runtime_error("Checkpoint has an invalid " + name);
+        }
+        return number;
+    }
+
+    void SearchCheckpoint::write(std::ostream &os) const
+    {
+        os << CHECKPOINT_HEADER << '\n'
+           << "algorithm " << algorithm << '\n'
+           << "parameters " << parameters << '\n'
+           << "instance " << elementCount << ' ' << subsetCount << '\n'
+           << "elapsed_ms " << elapsedMillis << '\n'
+           << "iteration " << iteration << '\n'
+           << "moves " << moveCount << '\n';
+        std::streamsize precision = os.precision(std::numeric_limits<double>::max_digits10);
+        os << "temperature " << temperature << '\n';
+        os.precision(precision);
+        os << "best_cost " << bestCost << '\n'
+           << "thread_random " << threadRandomState << '\n'
+           << "generator_random " << generatorRandomState << '\n'
+           << "solutions " << solutions.size() << '\n';
+        for (const std::vector<int> &solution : solutions)
+        {
+            os << solution.size();
+            for (int subset : solution)
+            {
+                os << ' ' << subset;
+            }
+            os << '\n';
+        }
+    }
+
+    SearchCheckpoint SearchCheckpoint::read(std::istream &is)
+    {
+        std::string header;
+        if (!std::getline(is, header) || header != CHECKPOINT_HEADER)
+        {
+            throw std::runtime_error("Not a checkpoint");
+        }
+
+        SearchCheckpoint checkpoint;
+        checkpoint.algorithm = readField(is, "algorithm");
+        checkpoint.parameters = readField(is, "parameters");
+        std::istringstream instance(readField(is, "instance"));
+        if (!(instance >> checkpoint.elementCount >> checkpoint.subsetCount))
+        {
+            throw std::runtime_error("Checkpoint has an invalid instance");
+        }
+        checkpoint.elapsedMillis = readNumberField<long>(is, "elapsed_ms");
+        checkpoint.iteration = readNumberField<long>(is, "iteration");
+        checkpoint.moveCount = readNumberField<long>(is, "moves");
+        checkpoint.temperature = std::stod(readField(is, "temperature"));
+        checkpoint.bestCost = readNumberField<int>(is, "best_cost");
+        checkpoint.threadRandomState = readField(is, "thread_random");
+        checkpoint.generatorRandomState = readField(is, "generator_random");
+
+        size_t solutionCount = readNumberField<size_t>(is, "solutions");
+        for (size_t i = 0; i < solutionCount; ++i)
+        {
+            std::vector<int> &solution = checkpoint.solutions.emplace_back();
+            size_t size;
+            if (!(is >> size))
+            {
+                throw std::runtime_error("Checkpoint is missing solution " + std::to_string(i));
+            }
+            solution.resize(size);
+            for (int &subset : solution)
+            {
+                if (!(is >> subset) || subset < 0 || subset >= checkpoint.subsetCount)
+                {
+                    throw std::runtime_error("Checkpoint has an invalid solution " + std::to_string(i));
+                }
+            }
+        }
+        return checkpoint;
+    }
+
+    CheckpointWriter::CheckpointWriter(std::string path, long intervalMillis)
+        : m_Path(std::move(path)), m_Interval(intervalMillis), m_NextSave(std::chrono::steady_clock::now() + m_Interval)
+    {
+        m_Thread = std::thread(&CheckpointWriter::writeLoop, this);
+    }
+
+    CheckpointWriter::~CheckpointWriter()
+    {
+        {
+            std::unique_lock lock(m_Mutex);
+            waitIdle(lock);
+            m_Stopping = true;
+        }
+        m_Changed.notify_all();
+        m_Thread.join();
+    }
+
+    void CheckpointWriter::writeLoop()
+    {
+        std::unique_lock lock(m_Mutex);
+        while (true)
+        {
+            m_Changed.wait(lock, [this]() { return m_Pending || m_Stopping; });
+            if (!m_Pending)
+            {
+                return;
+            }
+
+            SearchCheckpoint checkpoint = std::move(*m_Pending);
+            m_Pending.reset();
+            m_Writing = true;
+            lock.unlock();
+            std::exception_ptr error;
+            try
+            {
+                writeFile(checkpoint);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_Writing = false;
+            m_Error = error;
+            m_Changed.notify_all();
+        }
+    }
+
+    void CheckpointWriter::writeFile(const SearchCheckpoint &checkpoint) const
+    {
+        std::string temporaryPath = m_Path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Can not write checkpoint " + temporaryPath);
+            }
+            checkpoint.write(file);
+            if (!file.flush())
+            {
+                throw std::runtime_error("Could not write checkpoint " + temporaryPath);
+            }
+        }
+        std::filesystem::rename(temporaryPath, m_Path);
+    }
+
+    void CheckpointWriter::waitIdle(std::unique_lock<std::mutex> &lock)
+    {
+        m_Changed.wait(lock, [this]() { return !m_Pending && !m_Writing; });
+    }
+
+    std::optional<SearchCheckpoint> CheckpointWriter::begin()
+    {
+        {
+            std::unique_lock lock(m_Mutex);
+            waitIdle(lock);
+            m_Error = nullptr;
+        }
+        m_NextSave = std::chrono::steady_clock::now() + m_Interval;
+
+        std::ifstream file(m_Path);
+        if (!file.is_open())
+        {
+            return std::nullopt;
+        }
+        try
+        {
+            return SearchCheckpoint::read(file);
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error(m_Path + ": " + e.what());
+        }
+    }
+
+    void CheckpointWriter::save(SearchCheckpoint checkpoint)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_Error)
+            {
+                std::rethrow_exception(std::exchange(m_Error, nullptr));
+            }
+            m_Pending = std::move(checkpoint);
+        }
+        m_Changed.notify_all();
+        m_NextSave = std::chrono::steady_clock::now() + m_Interval;
+    }
+
+    void CheckpointWriter::finish()
+    {
+        {
+            std::unique_lock lock(m_Mutex);
+            waitIdle(lock);
+            m_Error = nullptr;
+        }
+        std::error_code error;
+        std::filesystem::remove(m_Path, error);
+    }
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief The state of a local search run, from which the run continues after its process stopped. Which fields a run
+     * uses depends on its algorithm.
+     */
+    struct SearchCheckpoint
+    {
+        std::string algorithm; // e.g. "vns"
+        std::string parameters; // The parameters the run was started with, only resumed with the same ones
+        int elementCount = 0;
+        int subsetCount = 0;
+
+        long elapsedMillis = 0; // Runtime spent before the checkpoint, taken from the time limit when resuming
+        long iteration = 0; // SA: temperature steps, VNS: rounds, BLGA: generations
+        long moveCount = 0; // SA: moves proposed
+        double temperature = 0.0; // SA
+        int bestCost = 0; // SA: best cost of the run, which may be below the current solution's
+        std::string threadRandomState; // See RandomSeed::saveState
+        std::string generatorRandomState; // SA: the generator of the acceptance draws
+
+        // SA and VNS: the current solution. BLGA: the leader, then the population
+        std::vector<std::vector<int>> solutions; // Sorted subset IDs
+
+        /**
+         * @brief Writes the checkpoint as text, one field per line, with the temperature written exactly.
+         */
+        void write(std::ostream &os) const;
+
+        /**
+         * @throws std::runtime_error If the stream does not hold a checkpoint.
+         */
+        static SearchCheckpoint read(std::istream &is);
+    };
+
+    /**
+     * @brief Saves the checkpoints of the runs of a solver to a file, from a background thread so the search only pays for
+     * the copy of its state. Each checkpoint is written to a temporary file first, then renamed over the previous one, so
+     * the file holds a whole checkpoint whenever the process stops. A checkpoint handed over while the previous one is still
+     * being written replaces any other waiting one, the older state being of no use anymore.
+     */
+    class CheckpointWriter
+    {
+    private:
+        std::string m_Path;
+        std::chrono::milliseconds m_Interval;
+        std::chrono::steady_clock::time_point m_NextSave;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Changed;
+        std::optional<SearchCheckpoint> m_Pending; // Guarded by m_Mutex, as are the fields below
+        bool m_Writing = false;
+        bool m_Stopping = false;
+        std::exception_ptr m_Error; // Of the last failed write, rethrown by the next save
+        std::thread m_Thread;
+
+        void writeLoop();
+        void writeFile(const SearchCheckpoint &checkpoint) const;
+
+        /**
+         * @brief Waits until the pending checkpoint, if any, has been written.
+         */
+        void waitIdle(std::unique_lock<std::mutex> &lock);
+
+    public:
+        /**
+         * @param intervalMillis The least time between two checkpoints of a run.
+         */
+        CheckpointWriter(std::string path, long intervalMillis);
+        ~CheckpointWriter();
+
+        CheckpointWriter(const CheckpointWriter &) = delete;
+        CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+        const std::string &path() const { return m_Path; }
+
+        /**
+         * @brief Starts timing the interval of a new run, and reads the checkpoint the file holds, if any.
+         *
+         * @throws std::runtime_error If the file is not a checkpoint.
+         */
+        std::optional<SearchCheckpoint> begin();
+
+        /**
+         * @brief Whether the interval has passed since the run began or last saved. Reads the clock, so runs call it once per
+         * iteration at most.
+         */
+        bool isDue() const { return std::chrono::steady_clock::now() >= m_NextSave; }
+
+        /**
+         * @brief Hands the checkpoint over to the background thread and starts timing the next interval.
+         *
+         * @throws std::runtime_error If writing the previous checkpoint failed.
+         */
+        void save(SearchCheckpoint checkpoint);
+
+        /**
+         * @brief Ends the run: waits for the checkpoint being written and removes the file, so the next run starts over.
+         */
+        void finish();
+    };
+
+}
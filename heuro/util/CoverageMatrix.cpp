@@ -0,0 +1,228 @@
+#include "CoverageMatrix.hpp"
+
+#include <bit>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define HE_COVERAGE_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace Heuro
+{
+
+    using Word = Bitset::Word;
+
+    static constexpr size_t MAX_COLUMN_WORDS = CoverageMatrix::MAX_ELEMENTS / Bitset::WORD_BITS;
+
+    static int countBits(const Word *words, size_t wordCount)
+    {
+        int count = 0;
+        for (size_t w = 0; w < wordCount; ++w)
+        {
+            count += std::popcount(words[w]);
+        }
+        return count;
+    }
+
+    // ORs the columns of the selected subsets into covered, checking after every word of the solution whether everything
+    // is covered already when stopAtFull is set, and returns how many elements are covered
+    static int unionScalar(const Word *columns, size_t columnWords, int elementCount, const Word *subsets, size_t subsetWords,
+        bool stopAtFull, Word *covered)
+    {
+        for (size_t w = 0; w < subsetWords; ++w)
+        {
+            Word word = subsets[w];
+            if (word == 0)
+            {
+                continue;
+            }
+            for (; word; word &= word - 1)
+            {
+                const Word *column = columns + (w * Bitset::WORD_BITS + std::countr_zero(word)) * columnWords;
+                for (size_t c = 0; c < columnWords; ++c)
+                {
+                    covered[c] |= column[c];
+                }
+            }
+            if (stopAtFull && countBits(covered, columnWords) == elementCount)
+            {
+                return elementCount;
+            }
+        }
+        return countBits(covered, columnWords);
+    }
+
+    static int intersectionCountScalar(const Word *column, const Word *elements, size_t wordCount)
+    {
+        int count = 0;
+        for (size_t w = 0; w < wordCount; ++w)
+        {
+            count += std::popcount(column[w] & elements[w]);
+        }
+        return count;
+    }
+
+    static int costScalar(const int32_t *costs, size_t wordCount, const Word *subsets)
+    {
+        int total = 0;
+        for (size_t w = 0; w < wordCount; ++w)
+        {
+            for (Word word = subsets[w]; word; word &= word - 1)
+            {
+                total += costs[w * Bitset::WORD_BITS + std::countr_zero(word)];
+            }
+        }
+        return total;
+    }
+
+#ifdef HE_COVERAGE_AVX2
+    // same as unionScalar four words at a time, the columns being padded to a whole number of vectors
+    __attribute__((target("avx2"))) static int unionAvx2(const Word *columns, size_t columnWords, int elementCount,
+        const Word *subsets, size_t subsetWords, bool stopAtFull, Word *covered)
+    {
+        for (size_t w = 0; w < subsetWords; ++w)
+        {
+            Word word = subsets[w];
+            if (word == 0)
+            {
+                continue;
+            }
+            for (; word; word &= word - 1)
+            {
+                const Word *column = columns + (w * Bitset::WORD_BITS + std::countr_zero(word)) * columnWords;
+                for (size_t c = 0; c < columnWords; c += 4)
+                {
+                    __m256i bits = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(covered + c)),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(column + c)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(covered + c), bits);
+                }
+            }
+            if (stopAtFull && countBits(covered, columnWords) == elementCount)
+            {
+                return elementCount;
+            }
+        }
+        return countBits(covered, columnWords);
+    }
+
+    // same as intersectionCountScalar, where std::popcount becomes a single instruction: every AVX2 CPU has POPCNT
+    __attribute__((target("avx2,popcnt"))) static int intersectionCountAvx2(const Word *column, const Word *elements, size_t wordCount)
+    {
+        int count = 0;
+        for (size_t w = 0; w < wordCount; ++w)
+        {
+            count += std::popcount(column[w] & elements[w]);
+        }
+        return count;
+    }
+
+    // expands each byte of the solution into a mask of 8 lanes, and adds the costs under it 8 at a time
+    __attribute__((target("avx2"))) static int costAvx2(const int32_t *costs, size_t wordCount, const Word *subsets)
+    {
+        const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        __m256i sum = _mm256_setzero_si256();
+        for (size_t w = 0; w < wordCount; ++w)
+        {
+            Word word = subsets[w];
+            for (int byte = 0; word; ++byte, word >>= 8)
+            {
+                int bits = static_cast<int>(word & 0xFF);
+                if (bits == 0)
+                {
+                    continue;
+                }
+                __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), laneBits), laneBits);
+                __m256i laneCosts = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(costs + w * Bitset::WORD_BITS + byte * 8));
+                sum = _mm256_add_epi32(sum, _mm256_and_si256(laneCosts, mask));
+            }
+        }
+
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+#endif
+
+    CoverageMatrix::CoverageMatrix(int elementCount, int subsetCount, Kernel kernel)
+        : m_ElementCount(elementCount), m_SubsetCount(subsetCount), m_Kernel(kernel)
+    {
+#ifndef HE_COVERAGE_AVX2
+        m_Kernel = Kernel::Scalar;
+#endif
+        // whole vectors per column, so that the AVX2 kernel needs no tail loop
+        size_t wordsPerVector = m_Kernel == Kernel::Avx2 ? 4 : 1;
+        size_t elementWords = (elementCount + Bitset::WORD_BITS - 1) / Bitset::WORD_BITS;
+        m_ColumnWords = (elementWords + wordsPerVector - 1) / wordsPerVector * wordsPerVector;
+        m_Columns.assign(subsetCount * m_ColumnWords, 0);
+
+        size_t subsetWords = (subsetCount + Bitset::WORD_BITS - 1) / Bitset::WORD_BITS;
+        m_Costs.assign(subsetWords * Bitset::WORD_BITS, 0);
+    }
+
+    CoverageMatrix::Kernel CoverageMatrix::bestKernel()
+    {
+#ifdef HE_COVERAGE_AVX2
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return Kernel::Avx2;
+        }
+#endif
+        return Kernel::Scalar;
+    }
+
+    const char *CoverageMatrix::kernelName(Kernel kernel)
+    {
+        return kernel == Kernel::Avx2 ? "avx2" : "scalar";
+    }
+
+    bool CoverageMatrix::isWorthwhile(int elementCount, int subsetCount)
+    {
+        constexpr size_t MAX_BYTES = size_t(2) << 20;
+
+        size_t columnWords = (elementCount + Bitset::WORD_BITS - 1) / Bitset::WORD_BITS;
+        return elementCount <= MAX_ELEMENTS && subsetCount * columnWords * sizeof(Word) <= MAX_BYTES;
+    }
+
+    int CoverageMatrix::uncoveredCount(const Bitset &subsets, bool stopAtFull) const
+    {
+        Word covered[MAX_COLUMN_WORDS] = {};
+        const Word *subsetWords = subsets.words().data();
+        size_t subsetWordCount = subsets.words().size();
+
+#ifdef HE_COVERAGE_AVX2
+        if (m_Kernel == Kernel::Avx2)
+        {
+            return m_ElementCount - unionAvx2(m_Columns.data(), m_ColumnWords, m_ElementCount, subsetWords, subsetWordCount,
+                stopAtFull, covered);
+        }
+#endif
+        return m_ElementCount - unionScalar(m_Columns.data(), m_ColumnWords, m_ElementCount, subsetWords, subsetWordCount,
+            stopAtFull, covered);
+    }
+
+    int CoverageMatrix::countContained(int subset, std::span<const Word> elements) const
+    {
+        const Word *column = m_Columns.data() + subset * m_ColumnWords;
+#ifdef HE_COVERAGE_AVX2
+        if (m_Kernel == Kernel::Avx2)
+        {
+            return intersectionCountAvx2(column, elements.data(), elements.size());
+        }
+#endif
+        return intersectionCountScalar(column, elements.data(), elements.size());
+    }
+
+    int CoverageMatrix::cost(const Bitset &subsets) const
+    {
+        size_t wordCount = m_Costs.size() / Bitset::WORD_BITS;
+#ifdef HE_COVERAGE_AVX2
+        if (m_Kernel == Kernel::Avx2)
+        {
+            return costAvx2(m_Costs.data(), wordCount, subsets.words().data());
+        }
+#endif
+        return costScalar(m_Costs.data(), wordCount, subsets.words().data());
+    }
+
+}
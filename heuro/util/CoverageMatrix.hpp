@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Bitset.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Dense backend of the coverage relation: a bit matrix with, for every subset, the bits of the elements it
+     * contains. The elements a solution covers are then the OR of the columns of its subsets, a word (or, with AVX2, four
+     * words) at a time, so checking a solution costs its size times m / 64 words no matter how long the relations are,
+     * and stops as soon as every element is covered. Worth it for small and medium instances (see isWorthwhile).
+     */
+    class CoverageMatrix
+    {
+    public:
+        enum class Kernel
+        {
+            Scalar,
+            Avx2, // Only available on x86 with GCC or Clang, picked at runtime when the CPU supports it
+        };
+
+        static constexpr int MAX_ELEMENTS = 4096; // The union of the columns is kept on the stack
+
+    private:
+        int m_ElementCount = 0;
+        int m_SubsetCount = 0;
+        size_t m_ColumnWords = 0; // Words per column
+        std::vector<Bitset::Word> m_Columns; // Column-major bits, column s holds the elements contained by subset s
+        std::vector<int32_t> m_Costs; // Cost of each subset, zero-padded to a whole number of words
+        Kernel m_Kernel;
+
+        int uncoveredCount(const Bitset &subsets, bool stopAtFull) const;
+
+    public:
+        CoverageMatrix(int elementCount, int subsetCount, Kernel kernel = bestKernel());
+
+        /**
+         * @brief The fastest kernel the running CPU supports.
+         */
+        static Kernel bestKernel();
+        static const char *kernelName(Kernel kernel);
+
+        /**
+         * @brief Whether the dense backend fits the instance: at most MAX_ELEMENTS elements, and a matrix small enough to stay
+         * in about the L2 cache.
+         */
+        static bool isWorthwhile(int elementCount, int subsetCount);
+
+        Kernel kernel() const { return m_Kernel; }
+        size_t bytes() const { return m_Columns.size() * sizeof(Bitset::Word) + m_Costs.size() * sizeof(int32_t); }
+
+        void set(int element, int subset)
+        {
+            m_Columns[subset * m_ColumnWords + element / Bitset::WORD_BITS] |= Bitset::Word(1) << (element % Bitset::WORD_BITS);
+        }
+
+        void setCost(int subset, int cost) { m_Costs[subset] = cost; }
+
+        /**
+         * @brief The amount of elements contained by the subset whose bits are set in elements, which holds a bit per
+         * element in words of Bitset::WORD_BITS (e.g. the elements a solution leaves uncovered).
+         */
+        int countContained(int subset, std::span<const Bitset::Word> elements) const;
+
+        /**
+         * @brief Whether the subsets set in the bitset cover every element. The bitset must have a bit per subset.
+         */
+        bool coversAll(const Bitset &subsets) const { return uncoveredCount(subsets, true) == 0; }
+
+        /**
+         * @brief The amount of elements the subsets set in the bitset leave uncovered.
+         */
+        int uncoveredCount(const Bitset &subsets) const { return uncoveredCount(subsets, false); }
+
+        /**
+         * @brief The total cost of the subsets set in the bitset.
+         */
+        int cost(const Bitset &subsets) const;
+    };
+
+}
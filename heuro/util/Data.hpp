@@ -1,6 +1,9 @@
 #pragma once
 
+#include "Bitset.hpp"
+
 #include <unordered_set>
+#include <vector>
 #include <ostream>
 
 namespace Heuro
@@ -12,7 +15,7 @@ namespace Heuro
         size_t subsetCount = 0;
         std::unordered_set<int> subsetIDs = {};
 
-        std::vector<int> toVec()
+        std::vector<int> toVec() const
         {
             std::vector<int> vec;
             vec.reserve(subsetIDs.size() + 2);
@@ -36,6 +39,31 @@ namespace Heuro
         }
     };
 
+    /**
+     * @brief A solution together with how far from optimal it is proven to be.
+     */
+    struct ScpExactResult
+    {
+        ScpResult solution;
+        int lowerBound = 0; // No solution costs less than this
+        double gap = 0.0; // (cost - lowerBound) / cost, zero once the solution is proven optimal
+        long nodeCount = 0; // Branch-and-bound nodes explored
+
+        bool isOptimal() const { return lowerBound >= solution.cost; }
+    };
+
+    /**
+     * @brief A BLGA chromosome together with its metadata, computed once when it enters the population.
+     */
+    struct BlgaIndividual
+    {
+        Bitset genes;
+        int cost = 0;
+        int selectedCount = 0;
+        bool feasible = false;
+        uint64_t hash = 0; // Zobrist hash of the genes
+    };
+
     struct ScpInput
     {
         int elementCount = 0; // m
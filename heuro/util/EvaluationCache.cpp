@@ -0,0 +1,35 @@
+#include "EvaluationCache.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Heuro
+{
+
+    EvaluationCache::EvaluationCache(size_t capacity)
+        : m_Slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 1)))),
+          m_Mask(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1)
+    {
+    }
+
+    void EvaluationCache::clear()
+    {
+        for (size_t i = 0; i <= m_Mask; ++i)
+        {
+            m_Slots[i].check.store(0, std::memory_order_relaxed);
+            m_Slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    EvaluationCacheStats EvaluationCache::stats() const
+    {
+        return { m_Lookups.load(std::memory_order_relaxed), m_Hits.load(std::memory_order_relaxed) };
+    }
+
+    void EvaluationCache::resetStats()
+    {
+        m_Lookups.store(0, std::memory_order_relaxed);
+        m_Hits.store(0, std::memory_order_relaxed);
+    }
+
+}
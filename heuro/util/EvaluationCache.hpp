@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Heuro
+{
+
+    /**
+     * @brief What evaluating a set of subsets from scratch yields.
+     */
+    struct Evaluation
+    {
+        int cost = 0;
+        int selectedCount = 0;
+        bool feasible = false;
+    };
+
+    struct EvaluationCacheStats
+    {
+        uint64_t lookups = 0;
+        uint64_t hits = 0;
+
+        double hitRate() const { return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups); }
+    };
+
+    /**
+     * @brief Bounded, lock-free cache of evaluations keyed by the Zobrist hash of the evaluated set (see ZobristHash).
+     * It is direct-mapped: each hash has a single slot, and a newer evaluation overwrites whatever shared it. Each slot
+     * stores the evaluation next to its hash XORed with it, so a read torn by a concurrent write fails the check and
+     * counts as a miss. One cache can therefore be shared by every solver of the same instance, on any thread.
+     */
+    class EvaluationCache
+    {
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> check{ 0 }; // hash ^ data
+            std::atomic<uint64_t> data{ 0 }; // The packed evaluation
+        };
+
+        std::unique_ptr<Slot[]> m_Slots;
+        size_t m_Mask;
+
+        std::atomic<uint64_t> m_Lookups{ 0 };
+        std::atomic<uint64_t> m_Hits{ 0 };
+
+        static uint64_t pack(const Evaluation &evaluation)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(evaluation.cost)) << 32)
+                | (static_cast<uint64_t>(static_cast<uint32_t>(evaluation.selectedCount) & 0x7FFFFFFFu) << 1)
+                | static_cast<uint64_t>(evaluation.feasible);
+        }
+
+        static Evaluation unpack(uint64_t data)
+        {
+            return { static_cast<int>(static_cast<uint32_t>(data >> 32)), static_cast<int>((data >> 1) & 0x7FFFFFFFu), (data & 1) != 0 };
+        }
+
+    public:
+        /**
+         * @param capacity The number of slots, rounded up to a power of two. Each one takes 16 bytes.
+         */
+        explicit EvaluationCache(size_t capacity = size_t(1) << 16);
+
+        /**
+         * @brief Looks up the evaluation of the set with the given hash.
+         *
+         * @return Whether it was found, in which case it is written to evaluation.
+         */
+        bool find(uint64_t hash, Evaluation &evaluation)
+        {
+            m_Lookups.fetch_add(1, std::memory_order_relaxed);
+            Slot &slot = m_Slots[hash & m_Mask];
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if ((check ^ data) != hash)
+            {
+                return false;
+            }
+
+            m_Hits.fetch_add(1, std::memory_order_relaxed);
+            evaluation = unpack(data);
+            return true;
+        }
+
+        void insert(uint64_t hash, const Evaluation &evaluation)
+        {
+            Slot &slot = m_Slots[hash & m_Mask];
+            uint64_t data = pack(evaluation);
+            slot.data.store(data, std::memory_order_relaxed);
+            slot.check.store(hash ^ data, std::memory_order_relaxed);
+        }
+
+        size_t capacity() const { return m_Mask + 1; }
+
+        /**
+         * @brief Forgets every evaluation, e.g. after the instance changes. Must not race with other calls.
+         */
+        void clear();
+
+        EvaluationCacheStats stats() const;
+        void resetStats();
+    };
+
+}
@@ -0,0 +1,193 @@
+#include "Executor.hpp"
+
+namespace Heuro
+{
+
+    // The executor the calling thread works for, and the index of its deque there
+    static thread_local const Executor *t_WorkerExecutor = nullptr;
+    static thread_local size_t t_WorkerIndex = 0;
+
+    Executor::Executor(unsigned int concurrency)
+    {
+        if (concurrency == 0)
+        {
+            concurrency = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (unsigned int i = 0; i < concurrency; ++i)
+        {
+            m_Deques.push_back(std::make_unique<TaskDeque>());
+        }
+        for (unsigned int worker = 0; worker + 1 < concurrency; ++worker)
+        {
+            m_Threads.emplace_back(&Executor::workerLoop, this, worker);
+        }
+    }
+
+    Executor::~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Stopping = true;
+        }
+        m_WakeUp.notify_all();
+        for (std::thread &thread : m_Threads)
+        {
+            thread.join();
+        }
+    }
+
+    Executor &Executor::global()
+    {
+        static Executor executor;
+        return executor;
+    }
+
+    size_t Executor::callerDeque() const
+    {
+        return t_WorkerExecutor == this ? t_WorkerIndex : m_Deques.size() - 1;
+    }
+
+    void Executor::submit(Task task)
+    {
+        {
+            TaskDeque &deque = *m_Deques[callerDeque()];
+            std::lock_guard<std::mutex> lock(deque.mutex);
+            deque.tasks.push_back(std::move(task));
+        }
+        m_QueuedTasks.fetch_add(1);
+
+        // taking the lock orders the new task before the check of any worker about to sleep
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+        }
+        m_WakeUp.notify_one();
+    }
+
+    bool Executor::takeOwnTask(TaskGroup &group, Task &task)
+    {
+        TaskDeque &deque = *m_Deques[callerDeque()];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        for (auto it = deque.tasks.rbegin(); it != deque.tasks.rend(); ++it)
+        {
+            if (it->group == &group)
+            {
+                task = std::move(*it);
+                deque.tasks.erase(std::next(it).base());
+                m_QueuedTasks.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Executor::takeAnyTask(size_t worker, Task &task)
+    {
+        {
+            TaskDeque &deque = *m_Deques[worker];
+            std::lock_guard<std::mutex> lock(deque.mutex);
+            if (!deque.tasks.empty())
+            {
+                task = std::move(deque.tasks.back());
+                deque.tasks.pop_back();
+                m_QueuedTasks.fetch_sub(1);
+                return true;
+            }
+        }
+
+        for (size_t offset = 1; offset < m_Deques.size(); ++offset)
+        {
+            TaskDeque &deque = *m_Deques[(worker + offset) % m_Deques.size()];
+            std::lock_guard<std::mutex> lock(deque.mutex);
+            if (!deque.tasks.empty())
+            {
+                task = std::move(deque.tasks.front());
+                deque.tasks.pop_front();
+                m_QueuedTasks.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Executor::workerLoop(size_t worker)
+    {
+        t_WorkerExecutor = this;
+        t_WorkerIndex = worker;
+
+        Task task;
+        while (true)
+        {
+            if (takeAnyTask(worker, task))
+            {
+                task.group->run(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_WakeUp.wait(lock, [this]() { return m_Stopping || m_QueuedTasks.load() > 0; });
+            if (m_Stopping)
+            {
+                return;
+            }
+        }
+    }
+
+    void TaskGroup::run(Executor::Task &task)
+    {
+        try
+        {
+            task.func();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_ErrorMutex);
+            if (!m_Error)
+            {
+                m_Error = std::current_exception();
+            }
+        }
+        task.func = nullptr;
+
+        // last access to the group, whose owner may destroy it as soon as nothing is pending
+        m_Pending.fetch_sub(1);
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void TaskGroup::wait()
+    {
+        Executor::Task task;
+        while (m_Pending.load() > 0)
+        {
+            if (m_Executor.takeOwnTask(*this, task))
+            {
+                run(task);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_ErrorMutex);
+            std::swap(error, m_Error);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Heuro
+{
+
+    class TaskGroup;
+
+    /**
+     * @brief A fixed pool of worker threads shared by all the parallel work of heuro, so that several solves running at once
+     * split the machine's cores instead of each starting its own threads.
+     * Each worker owns a deque of tasks: it runs the newest task of its own deque first, and steals the oldest one of another
+     * deque when its own is empty. Tasks are grouped in TaskGroups, and a thread waiting on a group runs that group's tasks
+     * itself, so work spawned from within a task (nested jobs) never deadlocks, even on a pool with a single thread.
+     */
+    class Executor
+    {
+        friend class TaskGroup;
+
+    private:
+        struct Task
+        {
+            std::function<void()> func;
+            TaskGroup *group = nullptr;
+        };
+
+        struct TaskDeque
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<TaskDeque>> m_Deques; // One per worker, and a last one for tasks spawned by other threads
+        std::vector<std::thread> m_Threads;
+
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WakeUp;
+        std::atomic<size_t> m_QueuedTasks = 0;
+        bool m_Stopping = false; // Guarded by m_SleepMutex
+
+        void submit(Task task);
+
+        /**
+         * @brief Takes the newest task of the given group from the calling thread's deque.
+         */
+        bool takeOwnTask(TaskGroup &group, Task &task);
+
+        /**
+         * @brief Takes the newest task of the worker's deque, or else the oldest task of any other deque.
+         */
+        bool takeAnyTask(size_t worker, Task &task);
+
+        void workerLoop(size_t worker);
+        size_t callerDeque() const;
+
+    public:
+        /**
+         * @param concurrency How many tasks run at once, counting the thread that waits on a TaskGroup, which helps running
+         * it. The pool starts concurrency - 1 worker threads. Zero picks the number of hardware threads.
+         */
+        explicit Executor(unsigned int concurrency = 0);
+        ~Executor();
+
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        unsigned int concurrency() const { return static_cast<unsigned int>(m_Threads.size()) + 1; }
+
+        /**
+         * @brief The executor shared by every solver that is not given one, sized to the hardware threads.
+         */
+        static Executor &global();
+
+        /**
+         * @brief Calls func(chunkBegin, chunkEnd) over consecutive chunks of [begin, end) of at most grain indices each, in
+         * parallel, and returns once every chunk is done. A grain of 0 splits the range in about four chunks per thread.
+         * The first exception thrown by a chunk is rethrown.
+         */
+        template<typename Func>
+        void parallelFor(size_t begin, size_t end, size_t grain, Func &&func);
+
+        /**
+         * @brief Maps every chunk of [begin, end) to a value with func(chunkBegin, chunkEnd), in parallel like parallelFor, and
+         * folds the values with reduce in the order of the chunks, starting from identity. The result does not depend on
+         * the concurrency as long as the grain does not.
+         */
+        template<typename T, typename Func, typename Reduce>
+        T parallelReduce(size_t begin, size_t end, size_t grain, T identity, Func &&func, Reduce &&reduce);
+
+    private:
+        size_t chunkSize(size_t count, size_t grain) const
+        {
+            return grain > 0 ? grain : std::max<size_t>(1, (count + 4 * concurrency() - 1) / (4 * concurrency()));
+        }
+    };
+
+    /**
+     * @brief A set of tasks spawned on an executor that can be waited on together.
+     */
+    class TaskGroup
+    {
+        friend class Executor;
+
+    private:
+        Executor &m_Executor;
+        std::atomic<size_t> m_Pending = 0;
+        std::mutex m_ErrorMutex;
+        std::exception_ptr m_Error;
+
+        void run(Executor::Task &task);
+
+    public:
+        explicit TaskGroup(Executor &executor)
+            : m_Executor(executor)
+        {
+        }
+
+        /**
+         * @brief Waits for the pending tasks, dropping their errors.
+         */
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        template<typename Func>
+        void spawn(Func &&func)
+        {
+            m_Pending.fetch_add(1);
+            m_Executor.submit({ std::forward<Func>(func), this });
+        }
+
+        /**
+         * @brief Returns once every spawned task has finished, running the group's tasks on the calling thread meanwhile.
+         * Rethrows the first exception thrown by a task.
+         */
+        void wait();
+    };
+
+    template<typename Func>
+    void Executor::parallelFor(size_t begin, size_t end, size_t grain, Func &&func)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        size_t chunk = chunkSize(end - begin, grain);
+        if (end - begin <= chunk)
+        {
+            func(begin, end);
+            return;
+        }
+
+        TaskGroup group(*this);
+        for (size_t chunkBegin = begin + chunk; chunkBegin < end; chunkBegin += chunk)
+        {
+            size_t chunkEnd = std::min(end, chunkBegin + chunk);
+            group.spawn([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); });
+        }
+        func(begin, begin + chunk);
+        group.wait();
+    }
+
+    template<typename T, typename Func, typename Reduce>
+    T Executor::parallelReduce(size_t begin, size_t end, size_t grain, T identity, Func &&func, Reduce &&reduce)
+    {
+        if (begin >= end)
+        {
+            return identity;
+        }
+
+        size_t chunk = chunkSize(end - begin, grain);
+        std::vector<std::optional<T>> values((end - begin + chunk - 1) / chunk);
+        parallelFor(begin, end, chunk, [&](size_t chunkBegin, size_t chunkEnd)
+        {
+            values[(chunkBegin - begin) / chunk].emplace(func(chunkBegin, chunkEnd));
+        });
+
+        T result = std::move(identity);
+        for (std::optional<T> &value : values)
+        {
+            result = reduce(std::move(result), std::move(*value));
+        }
+        return result;
+    }
+
+}
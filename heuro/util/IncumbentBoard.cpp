@@ -0,0 +1,286 @@
+#include "IncumbentBoard.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Heuro
+{
+
+    /**
+     * @brief The layout of the shared memory segment, followed by room for the IDs of every subset of the instance.
+     * Only lock-free atomics are used, since those work across processes.
+     */
+    struct IncumbentBoardSegment
+    {
+        static constexpr uint64_t MAGIC = 0x6865757230627264; // "heur0brd", stored last by the process that creates the segment
+
+        std::atomic<uint64_t> magic;
+        int32_t elementCount;
+        int32_t subsetCount;
+        pthread_mutex_t writerMutex; // Robust and process-shared, taken by the writers only
+        std::atomic<uint64_t> version; // Odd while a writer replaces the solution
+        std::atomic<int32_t> cost; // INT_MAX while there is no solution
+        std::atomic<int32_t> size;
+
+        int32_t *subsets() { return reinterpret_cast<int32_t *>(this + 1); }
+
+        static size_t bytes(int subsetCount) { return sizeof(IncumbentBoardSegment) + sizeof(int32_t) * subsetCount; }
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int32_t>::is_always_lock_free);
+    static_assert(alignof(IncumbentBoardSegment) % alignof(int32_t) == 0);
+
+    static constexpr auto ATTACH_TIMEOUT = std::chrono::seconds(5); // For the creator of the segment to finish setting it up
+    static constexpr int READ_ATTEMPTS = 1000;
+
+    static std::runtime_error systemError(const std::string &what, const std::string &name, int error)
+    {
+        return std::runtime_error(what + " incumbent board " + name + ": " + std::strerror(error));
+    }
+
+    static void initializeSegment(IncumbentBoardSegment &segment, int elementCount, int subsetCount)
+    {
+        segment.elementCount = elementCount;
+        segment.subsetCount = subsetCount;
+
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&segment.writerMutex, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+
+        segment.version.store(0, std::memory_order_relaxed);
+        segment.cost.store(INT_MAX, std::memory_order_relaxed);
+        segment.size.store(0, std::memory_order_relaxed);
+        segment.magic.store(IncumbentBoardSegment::MAGIC, std::memory_order_release);
+    }
+
+    // waits for the creator of the segment to size it, and returns its size
+    static size_t waitForSize(int fd, const std::string &name)
+    {
+        auto deadline = std::chrono::steady_clock::now() + ATTACH_TIMEOUT;
+        struct stat status{};
+        while (true)
+        {
+            if (fstat(fd, &status) != 0)
+            {
+                throw systemError("Can not read", name, errno);
+            }
+            if (status.st_size > 0)
+            {
+                return static_cast<size_t>(status.st_size);
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                throw std::runtime_error("Incumbent board " + name + " was never set up, remove it and try again");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /**
+     * @brief Takes the writer mutex. If its owner died while holding it, possibly halfway through copying a solution, the
+     * board is emptied so readers never see the torn copy.
+     */
+    static void lockWriters(IncumbentBoardSegment &segment)
+    {
+        int error = pthread_mutex_lock(&segment.writerMutex);
+        if (error == EOWNERDEAD)
+        {
+            uint64_t version = segment.version.load(std::memory_order_relaxed);
+            if (version % 2 == 1)
+            {
+                segment.size.store(0, std::memory_order_relaxed);
+                segment.cost.store(INT_MAX, std::memory_order_relaxed);
+                segment.version.store(version + 1, std::memory_order_release);
+            }
+            pthread_mutex_consistent(&segment.writerMutex);
+        }
+        else if (error != 0)
+        {
+            throw std::runtime_error(std::string("Can not lock an incumbent board: ") + std::strerror(error));
+        }
+    }
+
+    IncumbentBoard::IncumbentBoard(const std::string &name, int elementCount, int subsetCount)
+        : m_Name(name), m_Size(IncumbentBoardSegment::bytes(subsetCount))
+    {
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        bool isCreator = fd >= 0;
+        if (!isCreator && errno == EEXIST)
+        {
+            fd = shm_open(name.c_str(), O_RDWR, 0);
+        }
+        if (fd < 0)
+        {
+            throw systemError("Can not open", name, errno);
+        }
+
+        if (isCreator && ftruncate(fd, static_cast<off_t>(m_Size)) != 0)
+        {
+            int error = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            throw systemError("Can not size", name, error);
+        }
+        if (!isCreator && waitForSize(fd, name) != m_Size)
+        {
+            close(fd);
+            throw std::runtime_error("Incumbent board " + name + " holds an instance of another size");
+        }
+
+        void *memory = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd);
+        if (memory == MAP_FAILED)
+        {
+            throw systemError("Can not map", name, error);
+        }
+        m_Segment = static_cast<IncumbentBoardSegment *>(memory);
+
+        if (isCreator)
+        {
+            initializeSegment(*new (memory) IncumbentBoardSegment, elementCount, subsetCount);
+            return;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + ATTACH_TIMEOUT;
+        while (m_Segment->magic.load(std::memory_order_acquire) != IncumbentBoardSegment::MAGIC)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                munmap(memory, m_Size);
+                throw std::runtime_error("Incumbent board " + name + " was never set up, remove it and try again");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (m_Segment->elementCount != elementCount || m_Segment->subsetCount != subsetCount)
+        {
+            munmap(memory, m_Size);
+            throw std::runtime_error("Incumbent board " + name + " holds an instance of another size");
+        }
+    }
+
+    IncumbentBoard::~IncumbentBoard()
+    {
+        munmap(m_Segment, m_Size);
+    }
+
+    std::string IncumbentBoard::segmentName(const std::string &prefix, const std::string &instance)
+    {
+        std::string name = "/" + prefix + "." + instance;
+        for (size_t i = 1; i < name.size(); ++i)
+        {
+            char c = name[i];
+            bool isValid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '_';
+            if (!isValid)
+            {
+                name[i] = '_';
+            }
+        }
+        return name;
+    }
+
+    bool IncumbentBoard::remove(const std::string &name)
+    {
+        return shm_unlink(name.c_str()) == 0;
+    }
+
+    int IncumbentBoard::bestCost() const
+    {
+        return m_Segment->cost.load(std::memory_order_relaxed);
+    }
+
+    bool IncumbentBoard::publish(const ScpResult &solution)
+    {
+        const int subsetCount = m_Segment->subsetCount;
+        for (int subset : solution.subsetIDs)
+        {
+            if (subset < 0 || subset >= subsetCount)
+            {
+                throw std::invalid_argument("Solution selects subset " + std::to_string(subset) + ", which the instance does not have");
+            }
+        }
+        if (solution.cost >= bestCost())
+        {
+            return false;
+        }
+
+        lockWriters(*m_Segment);
+        bool isCheaper = solution.cost < m_Segment->cost.load(std::memory_order_relaxed);
+        if (isCheaper)
+        {
+            // the odd version keeps readers from trusting the copy until the final store makes it even again
+            uint64_t version = m_Segment->version.load(std::memory_order_relaxed);
+            m_Segment->version.store(version + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            int32_t *subsets = m_Segment->subsets();
+            int size = 0;
+            for (int subset : solution.subsetIDs)
+            {
+                std::atomic_ref<int32_t>(subsets[size++]).store(subset, std::memory_order_relaxed);
+            }
+            m_Segment->size.store(size, std::memory_order_relaxed);
+            m_Segment->cost.store(solution.cost, std::memory_order_relaxed);
+            m_Segment->version.store(version + 2, std::memory_order_release);
+        }
+        pthread_mutex_unlock(&m_Segment->writerMutex);
+        return isCheaper;
+    }
+
+    std::optional<ScpResult> IncumbentBoard::read() const
+    {
+        const int subsetCount = m_Segment->subsetCount;
+        int32_t *subsets = m_Segment->subsets();
+        std::vector<int> copy;
+        for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt)
+        {
+            uint64_t version = m_Segment->version.load(std::memory_order_acquire);
+            if (version % 2 == 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            int cost = m_Segment->cost.load(std::memory_order_relaxed);
+            int size = std::clamp(m_Segment->size.load(std::memory_order_relaxed), 0, subsetCount);
+            copy.resize(size);
+            for (int i = 0; i < size; ++i)
+            {
+                copy[i] = std::atomic_ref<int32_t>(subsets[i]).load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_Segment->version.load(std::memory_order_relaxed) != version)
+            {
+                continue;
+            }
+
+            if (cost == INT_MAX)
+            {
+                return std::nullopt;
+            }
+            std::unordered_set<int> subsetIDs(copy.begin(), copy.end());
+            return ScpResult{ cost, subsetIDs.size(), std::move(subsetIDs) };
+        }
+        return std::nullopt;
+    }
+
+}
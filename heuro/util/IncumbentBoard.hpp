@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Data.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace Heuro
+{
+
+    struct IncumbentBoardSegment;
+
+    /**
+     * @brief The best solution known for an instance, kept in a POSIX shared memory segment (see shm_open) that any process
+     * of the machine may attach to by name, so that separate runs on the same instance cooperate like the threads of a
+     * portfolio: each one publishes the solutions that beat the board, and restarts from (or prunes against) the board's
+     * solution once it is cheaper than its own.
+     * Reading never blocks nor locks. The solution is guarded by a version counter (a seqlock), odd while a writer copies a
+     * new solution in, and readers retry until they see the same even version before and after their copy. Writers take a
+     * robust process-shared mutex, so a process that dies while publishing leaves the board empty instead of locked.
+     * The segment outlives the processes, keeping its solution for the next runs until remove() unlinks it.
+     */
+    class IncumbentBoard
+    {
+    private:
+        std::string m_Name;
+        IncumbentBoardSegment *m_Segment = nullptr;
+        size_t m_Size = 0;
+
+    public:
+        /**
+         * @brief Attaches to the segment of the given name, and creates it empty if no process has yet.
+         *
+         * @param name The name of the segment, see segmentName().
+         * @throws std::runtime_error If the segment can not be created or mapped, or holds an instance of other dimensions.
+         */
+        IncumbentBoard(const std::string &name, int elementCount, int subsetCount);
+        ~IncumbentBoard();
+
+        IncumbentBoard(const IncumbentBoard &) = delete;
+        IncumbentBoard &operator=(const IncumbentBoard &) = delete;
+
+        /**
+         * @brief The name of the segment of an instance, e.g. "/heuro.scp41" for prefix "heuro". Characters that are not valid
+         * in a segment name are replaced with '_'.
+         */
+        static std::string segmentName(const std::string &prefix, const std::string &instance);
+
+        /**
+         * @brief Unlinks the segment of the given name. The processes attached to it keep using it until they detach.
+         *
+         * @return Whether the segment existed.
+         */
+        static bool remove(const std::string &name);
+
+        const std::string &name() const { return m_Name; }
+
+        /**
+         * @brief The cost of the board's solution, or INT_MAX while it has none. A single atomic load, cheap enough to poll
+         * every iteration of a search.
+         */
+        int bestCost() const;
+
+        /**
+         * @brief Replaces the board's solution with the given one if it is cheaper.
+         *
+         * @return Whether the solution was published.
+         * @throws std::invalid_argument If the solution selects a subset the instance does not have.
+         */
+        bool publish(const ScpResult &solution);
+
+        /**
+         * @brief A consistent copy of the board's solution, or nothing while it has none, or if writers kept replacing it
+         * for the whole read.
+         */
+        std::optional<ScpResult> read() const;
+    };
+
+}
@@ -0,0 +1,168 @@
+#include "Lagrangian.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Heuro
+{
+
+    template<typename Traits>
+    LagrangianRelaxation<Traits>::LagrangianRelaxation(int elementCount, const CostTable<typename Traits::Cost> &costs, const std::vector<std::vector<Index>> &subsetElements)
+        : m_ElementCount(elementCount), m_Costs(costs), m_SubsetElements(subsetElements),
+        m_ActiveElements(elementCount, 1), m_ReducedCosts(costs.size()), m_Coverage(elementCount)
+    {
+    }
+
+    template<typename Traits>
+    void LagrangianRelaxation<Traits>::setFixedSubsets(const std::vector<signed char> *fixedSubsets)
+    {
+        m_FixedSubsets = fixedSubsets;
+        std::fill(m_ActiveElements.begin(), m_ActiveElements.end(), 1);
+        if (!m_FixedSubsets)
+        {
+            return;
+        }
+        for (size_t subset = 0; subset < m_SubsetElements.size(); ++subset)
+        {
+            if ((*m_FixedSubsets)[subset] > 0)
+            {
+                for (Index element : m_SubsetElements[subset])
+                {
+                    m_ActiveElements[element] = 0;
+                }
+            }
+        }
+    }
+
+    template<typename Traits>
+    std::vector<double> LagrangianRelaxation<Traits>::initialMultipliers() const
+    {
+        std::vector<double> multipliers(m_ElementCount, std::numeric_limits<double>::max());
+        for (size_t subset = 0; subset < m_SubsetElements.size(); ++subset)
+        {
+            const auto &elements = m_SubsetElements[subset];
+            if (elements.empty())
+            {
+                continue;
+            }
+            double costPerElement = static_cast<double>(m_Costs[subset]) / static_cast<double>(elements.size());
+            for (Index element : elements)
+            {
+                multipliers[element] = std::min(multipliers[element], costPerElement);
+            }
+        }
+        for (double &multiplier : multipliers)
+        {
+            if (multiplier == std::numeric_limits<double>::max())
+            {
+                multiplier = 0.0; // uncoverable element, the instance is infeasible anyway
+            }
+        }
+        return multipliers;
+    }
+
+    template<typename Traits>
+    void LagrangianRelaxation<Traits>::reducedCosts(const std::vector<double> &multipliers, std::vector<double> &reducedCosts) const
+    {
+        reducedCosts.resize(m_SubsetElements.size());
+        for (size_t subset = 0; subset < m_SubsetElements.size(); ++subset)
+        {
+            double reducedCost = m_Costs[subset];
+            for (Index element : m_SubsetElements[subset])
+            {
+                reducedCost -= multipliers[element];
+            }
+            reducedCosts[subset] = reducedCost;
+        }
+    }
+
+    template<typename Traits>
+    double LagrangianRelaxation<Traits>::evaluate(const std::vector<double> &multipliers)
+    {
+        reducedCosts(multipliers, m_ReducedCosts);
+
+        double bound = 0.0;
+        for (double multiplier : multipliers)
+        {
+            bound += multiplier; // zero for the elements out of the relaxation
+        }
+        std::fill(m_Coverage.begin(), m_Coverage.end(), 0);
+        for (size_t subset = 0; subset < m_ReducedCosts.size(); ++subset)
+        {
+            bool isFree = !m_FixedSubsets || (*m_FixedSubsets)[subset] == 0;
+            if (isFree && m_ReducedCosts[subset] < 0.0)
+            {
+                bound += m_ReducedCosts[subset];
+                for (Index element : m_SubsetElements[subset])
+                {
+                    m_Coverage[element] += 1;
+                }
+            }
+        }
+        return bound;
+    }
+
+    template<typename Traits>
+    LagrangianBound LagrangianRelaxation<Traits>::optimize(double upperBound, std::vector<double> multipliers, int maxIterations)
+    {
+        constexpr int STALL_LIMIT = 20; // Steps without improving the bound before the step size is halved
+        constexpr double MIN_STEP_FACTOR = 0.005;
+
+        for (int element = 0; element < m_ElementCount; ++element)
+        {
+            if (!m_ActiveElements[element])
+            {
+                multipliers[element] = 0.0;
+            }
+        }
+
+        LagrangianBound best{ -std::numeric_limits<double>::max(), multipliers };
+        double stepFactor = 2.0;
+        int stalledSteps = 0;
+        for (int iteration = 0; iteration < maxIterations && stepFactor > MIN_STEP_FACTOR; ++iteration)
+        {
+            double bound = evaluate(multipliers);
+            if (bound > best.lowerBound)
+            {
+                best.lowerBound = bound;
+                best.multipliers = multipliers;
+                stalledSteps = 0;
+            }
+            else if (++stalledSteps == STALL_LIMIT)
+            {
+                stepFactor /= 2.0;
+                stalledSteps = 0;
+            }
+
+            // the subgradient of element i is 1 - (times it is covered), it is zero once every element is covered exactly once
+            double squaredNorm = 0.0;
+            for (int element = 0; element < m_ElementCount; ++element)
+            {
+                double subgradient = m_ActiveElements[element] ? 1.0 - m_Coverage[element] : 0.0;
+                squaredNorm += subgradient * subgradient;
+            }
+            if (squaredNorm == 0.0 || best.lowerBound >= upperBound)
+            {
+                break; // the relaxed solution is a cover, so no better bound exists
+            }
+
+            double step = stepFactor * (upperBound - bound) / squaredNorm;
+            for (int element = 0; element < m_ElementCount; ++element)
+            {
+                if (m_ActiveElements[element])
+                {
+                    multipliers[element] = std::max(0.0, multipliers[element] + step * (1.0 - m_Coverage[element]));
+                }
+            }
+        }
+        return best;
+    }
+
+    template class LagrangianRelaxation<ScpTraitsU16>;
+    template class LagrangianRelaxation<ScpTraitsU16Wide>;
+    template class LagrangianRelaxation<ScpTraitsU16Unicost>;
+    template class LagrangianRelaxation<ScpTraitsU32>;
+    template class LagrangianRelaxation<ScpTraitsU32Wide>;
+    template class LagrangianRelaxation<ScpTraitsU32Unicost>;
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "ScpTraits.hpp"
+
+#include <vector>
+
+namespace Heuro
+{
+
+    struct LagrangianBound
+    {
+        double lowerBound = 0.0;
+        std::vector<double> multipliers; // One per element
+    };
+
+    /**
+     * @brief Lagrangian relaxation of the covering constraints of an SCP instance, optimized by subgradient ascent.
+     * Relaxing every constraint with a multiplier u_i >= 0 leaves the bound L(u) = sum(u_i) + sum(min(0, rc_j)), where
+     * rc_j = c_j - sum(u_i for the elements i of subset j) is the reduced cost of subset j. The reduced costs also price
+     * the subsets: the lower they are, the likelier a subset is to belong to a good solution.
+     *
+     * @tparam Traits The representation of the instance (see ScpTraits).
+     */
+    template<typename Traits>
+    class LagrangianRelaxation
+    {
+    private:
+        using Index = typename Traits::Index;
+
+        int m_ElementCount;
+        const CostTable<typename Traits::Cost> &m_Costs;
+        const std::vector<std::vector<Index>> &m_SubsetElements;
+
+        const std::vector<signed char> *m_FixedSubsets = nullptr;
+        std::vector<char> m_ActiveElements; // Elements not yet covered by a subset fixed into the solution
+
+        std::vector<double> m_ReducedCosts;
+        std::vector<int> m_Coverage; // Times each element is covered by the subsets with a negative reduced cost
+
+        double evaluate(const std::vector<double> &multipliers);
+
+    public:
+        /**
+         * @brief Keeps references to the instance, which must outlive the relaxation.
+         */
+        LagrangianRelaxation(int elementCount, const CostTable<typename Traits::Cost> &costs, const std::vector<std::vector<Index>> &subsetElements);
+
+        /**
+         * @brief Restricts the relaxation to the subproblem of a branch-and-bound node, or lifts the restriction if given nullptr.
+         * Subsets fixed into the solution (1) or out of it (-1) are left out of the relaxation, and so are the elements covered
+         * by the former, whose multipliers are kept at zero. Free subsets are marked with 0. The vector must outlive its use.
+         */
+        void setFixedSubsets(const std::vector<signed char> *fixedSubsets);
+
+        /**
+         * @brief The usual starting multipliers: for each element, the lowest cost per covered element among its subsets.
+         */
+        std::vector<double> initialMultipliers() const;
+
+        /**
+         * @brief Improves the multipliers by subgradient ascent, halving the step size whenever the bound stalls.
+         *
+         * @param upperBound The cost of a known solution, which scales the step size.
+         * @param multipliers The starting multipliers.
+         * @param maxIterations The maximum amount of subgradient steps.
+         *
+         * @return The best bound found, together with the multipliers that give it. With fixed subsets, the bound does not include
+         * the cost of the subsets fixed into the solution.
+         */
+        LagrangianBound optimize(double upperBound, std::vector<double> multipliers, int maxIterations);
+
+        /**
+         * @brief Computes the reduced cost of every subset under the given multipliers.
+         */
+        void reducedCosts(const std::vector<double> &multipliers, std::vector<double> &reducedCosts) const;
+    };
+
+    extern template class LagrangianRelaxation<ScpTraitsU16>;
+    extern template class LagrangianRelaxation<ScpTraitsU16Wide>;
+    extern template class LagrangianRelaxation<ScpTraitsU16Unicost>;
+    extern template class LagrangianRelaxation<ScpTraitsU32>;
+    extern template class LagrangianRelaxation<ScpTraitsU32Wide>;
+    extern template class LagrangianRelaxation<ScpTraitsU32Unicost>;
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "RandomRealGenerator.hpp"
+
+#include "debug/SearchStats.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Move generator made of the neighbourhoods of an owner, member functions that move a solution in place, tried in
+     * the given order. Each one is a template argument, so the engine calls it directly instead of dispatching on an index.
+     *
+     * @tparam Owner The class of the neighbourhoods, usually the solver.
+     * @tparam Solution The solution type the neighbourhoods move.
+     */
+    template<typename Owner, typename Solution, void (Owner::*... Neighbourhoods)(Solution &)>
+    class NeighbourhoodSequence
+    {
+    private:
+        Owner &m_Owner;
+
+    public:
+        static constexpr size_t LEVEL_COUNT = sizeof...(Neighbourhoods);
+
+        explicit NeighbourhoodSequence(Owner &owner)
+            : m_Owner(owner)
+        {
+        }
+
+        template<size_t Level>
+        void move(Solution &solution) const
+        {
+            constexpr auto neighbourhood = std::get<Level>(std::tuple{ Neighbourhoods... });
+            (m_Owner.*neighbourhood)(solution);
+        }
+    };
+
+    /**
+     * @brief Accepts the neighbours that cost no more than the current solution, as a descent does.
+     */
+    struct NonWorseningAcceptance
+    {
+        bool operator()(int deltaCost, double) const { return deltaCost <= 0; }
+    };
+
+    /**
+     * @brief Accepts every neighbour that costs no more than the current solution, and a costlier one with probability
+     * e^(-delta / temperature), as simulated annealing does. Draws a number for the costlier neighbours only.
+     */
+    class MetropolisAcceptance
+    {
+    private:
+        RandomRealGenerator m_RandGen{ 0.0, 1.0 };
+
+    public:
+        bool operator()(int deltaCost, double temperature)
+        {
+            return deltaCost <= 0 || m_RandGen() <= std::exp(-deltaCost / temperature);
+        }
+
+        std::string saveState() const { return m_RandGen.saveState(); }
+        void restoreState(const std::string &state) { m_RandGen.restoreState(state); }
+    };
+
+    /**
+     * @brief Temperature given by a function of the initial temperature and the step number, called once per step.
+     */
+    class FunctionCooling
+    {
+    private:
+        const std::function<double(double, int)> &m_Schedule;
+        double m_InitialTemperature;
+        double m_Temperature;
+
+    public:
+        FunctionCooling(const std::function<double(double, int)> &schedule, double initialTemperature)
+            : m_Schedule(schedule), m_InitialTemperature(initialTemperature), m_Temperature(initialTemperature)
+        {
+        }
+
+        double temperature() const { return m_Temperature; }
+        void cool(long step) { m_Temperature = m_Schedule(m_InitialTemperature, static_cast<int>(step)); }
+        void restore(double temperature) { m_Temperature = temperature; }
+    };
+
+    /**
+     * @brief Constant temperature, for the acceptance criteria that ignore it.
+     */
+    struct NoCooling
+    {
+        double temperature() const { return 1.0; }
+        void cool(long) {}
+        void restore(double) {}
+    };
+
+    /**
+     * @brief Trajectory search engine, specialized at compile time on its policies so the whole inner loop inlines:
+     *  - Moves: NeighbourhoodSequence-like, with LEVEL_COUNT neighbourhoods and move<Level>(solution).
+     *  - Acceptance: bool (int deltaCost, double temperature), whether the current solution moves to the neighbour.
+     *  - Cooling: temperature(), cool(step) once each step ends, and restore(temperature) when resuming a run.
+     *  - Stop: hasStopped() before each step and tick() after it, as Timer does.
+     * The search runs in steps (SA: a temperature, VNS: a round) of movesPerStep moves each, until the stop condition holds
+     * or the temperature reaches zero. A move tries the neighbourhoods in order until one of their neighbours is accepted,
+     * and the next move starts over from the first one.
+     * The solution type must be copyable into an existing solution without allocating, like BasicScpSolution.
+     */
+    template<typename Solution, typename Moves, typename Acceptance, typename Cooling, typename Stop>
+    class LocalSearch
+    {
+    private:
+        Moves m_Moves;
+        Acceptance m_Acceptance;
+        Cooling m_Cooling;
+        Stop m_Stop;
+        int m_MovesPerStep;
+        SearchStats &m_Stats;
+
+        long m_Step = 0;
+        long m_MoveCount = 0;
+        int m_BestCost = INT_MAX;
+
+        template<size_t Level>
+        bool tryNeighbourhood(Solution &current, Solution &neighbour)
+        {
+            neighbour = current;
+            m_Moves.template move<Level>(neighbour);
+            HE_STATS_INCREMENT(m_Stats.movesProposed);
+
+            int deltaCost = neighbour.cost() - current.cost();
+            if (!m_Acceptance(deltaCost, m_Cooling.temperature()))
+            {
+                return false;
+            }
+            std::swap(current, neighbour);
+            HE_STATS_INCREMENT(m_Stats.movesAccepted);
+            HE_STATS_ADD(m_Stats.movesImproving, deltaCost < 0);
+            return true;
+        }
+
+        template<size_t... Levels>
+        void move(Solution &current, Solution &neighbour, std::index_sequence<Levels...>)
+        {
+            (tryNeighbourhood<Levels>(current, neighbour) || ...);
+        }
+
+    public:
+        LocalSearch(Moves moves, Acceptance acceptance, Cooling cooling, Stop stop, int movesPerStep, SearchStats &stats)
+            : m_Moves(std::move(moves)), m_Acceptance(std::move(acceptance)), m_Cooling(std::move(cooling)), m_Stop(std::move(stop)),
+            m_MovesPerStep(movesPerStep), m_Stats(stats)
+        {
+        }
+
+        Acceptance &acceptance() { return m_Acceptance; }
+        Cooling &cooling() { return m_Cooling; }
+        const Stop &stop() const { return m_Stop; }
+
+        long step() const { return m_Step; } // Steps done
+        long moveCount() const { return m_MoveCount; } // Moves done
+        int bestCost() const { return m_BestCost; } // Of the run, which may be below the current solution's
+
+        /**
+         * @brief Continues the counters of a run that was checkpointed.
+         */
+        void resume(long step, long moveCount, int bestCost)
+        {
+            m_Step = step;
+            m_MoveCount = moveCount;
+            m_BestCost = bestCost;
+        }
+
+        /**
+         * @brief Moves the current solution until the search stops. The hooks are called with the current solution:
+         * beforeStep as each step starts, afterMove after each move and afterStep as each step ends, before the counters are
+         * updated. afterStep may replace the solution (e.g. with a better one found elsewhere), which then counts towards the
+         * best cost.
+         */
+        template<typename BeforeStep, typename AfterMove, typename AfterStep>
+        void run(Solution &current, BeforeStep &&beforeStep, AfterMove &&afterMove, AfterStep &&afterStep)
+        {
+            Solution neighbour = current;
+            m_BestCost = std::min(m_BestCost, current.cost());
+            while (!m_Stop.hasStopped() && m_Cooling.temperature() > 0.0)
+            {
+                beforeStep(current);
+                for (int i = 0; i < m_MovesPerStep; ++i)
+                {
+                    move(current, neighbour, std::make_index_sequence<Moves::LEVEL_COUNT>());
+                    m_BestCost = std::min(m_BestCost, current.cost());
+                    afterMove(current);
+                    m_MoveCount += 1;
+                }
+
+                afterStep(current);
+                m_BestCost = std::min(m_BestCost, current.cost());
+                m_Step += 1;
+                HE_STATS_INCREMENT(m_Stats.generations);
+                m_Stop.tick();
+                m_Cooling.cool(m_Step);
+            }
+        }
+    };
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RandomSeed.hpp"
+
 #include <random>
 
 namespace Heuro
@@ -13,7 +15,7 @@ namespace Heuro
 
     public:
         explicit RandomBinaryGenerator(double probability = 0.5)
-            : m_RandomEngine(std::random_device{}()), m_Distribution(probability)
+            : m_RandomEngine(RandomSeed::next()), m_Distribution(probability)
         {
         }
 
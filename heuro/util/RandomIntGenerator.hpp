@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RandomSeed.hpp"
+
 #include <random>
 
 namespace Heuro
@@ -13,7 +15,7 @@ namespace Heuro
 
     public:
         RandomIntGenerator(int low, int high)
-            : m_RandomEngine(std::random_device{}()), m_Distribution(low, high - 1)
+            : m_RandomEngine(RandomSeed::next()), m_Distribution(low, high - 1)
         {
         }
 
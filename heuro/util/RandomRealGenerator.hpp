@@ -1,6 +1,10 @@
 #pragma once
 
+#include "RandomSeed.hpp"
+
 #include <random>
+#include <sstream>
+#include <string>
 
 namespace Heuro
 {
@@ -13,7 +17,7 @@ namespace Heuro
 
     public:
         RandomRealGenerator(double low, double high)
-            : m_RandomEngine(std::random_device{}()), m_Distribution(low, high)
+            : m_RandomEngine(RandomSeed::next()), m_Distribution(low, high)
         {
         }
 
@@ -21,6 +25,22 @@ namespace Heuro
         {
             return m_Distribution(m_RandomEngine);
         }
+
+        /**
+         * @brief The state of the generator as text, to draw the same numbers again once restored.
+         */
+        std::string saveState() const
+        {
+            std::ostringstream state;
+            state << m_RandomEngine;
+            return state.str();
+        }
+
+        void restoreState(const std::string &state)
+        {
+            std::istringstream stream(state);
+            stream >> m_RandomEngine;
+        }
     };
 
 }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Source of the seeds of every random generator in heuro. By default each generator is seeded from
+     * std::random_device; once a thread sets a seed, the generators it creates draw their seeds from a deterministic
+     * sequence instead, so a whole run can be reproduced.
+     */
+    class RandomSeed
+    {
+    private:
+        static std::optional<std::mt19937_64> &threadEngine()
+        {
+            thread_local std::optional<std::mt19937_64> engine;
+            return engine;
+        }
+
+    public:
+        /**
+         * @brief Makes the generators created from now on by the calling thread reproducible.
+         */
+        static void set(uint64_t seed)
+        {
+            threadEngine().emplace(seed);
+        }
+
+        /**
+         * @brief Goes back to seeding the calling thread's generators from std::random_device.
+         */
+        static void clear()
+        {
+            threadEngine().reset();
+        }
+
+        /**
+         * @brief Seeds the calling thread's generators from the given seed until the scope ends, then restores whatever
+         * seeding the thread had before. Lets a task reproduce its randomness on whichever thread runs it.
+         */
+        class Scope
+        {
+        private:
+            std::optional<std::mt19937_64> m_Saved;
+
+        public:
+            explicit Scope(uint64_t seed)
+                : m_Saved(std::move(threadEngine()))
+            {
+                threadEngine().emplace(seed);
+            }
+
+            ~Scope()
+            {
+                threadEngine() = std::move(m_Saved);
+            }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+        };
+
+        /**
+         * @brief The state of the calling thread's seed sequence as text, or an empty string if the thread seeds from
+         * std::random_device. Restoring it makes the thread draw the same seeds again.
+         */
+        static std::string saveState()
+        {
+            std::ostringstream state;
+            if (threadEngine())
+            {
+                state << *threadEngine();
+            }
+            return state.str();
+        }
+
+        static void restoreState(const std::string &state)
+        {
+            if (state.empty())
+            {
+                clear();
+                return;
+            }
+            std::istringstream stream(state);
+            std::mt19937_64 engine;
+            stream >> engine;
+            threadEngine().emplace(engine);
+        }
+
+        static uint32_t next()
+        {
+            auto &engine = threadEngine();
+            return engine ? static_cast<uint32_t>((*engine)()) : std::random_device{}();
+        }
+    };
+
+}
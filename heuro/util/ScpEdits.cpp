@@ -0,0 +1,94 @@
+#include "ScpEdits.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace Heuro
+{
+
+    static void checkId(int id, int count, const char *what)
+    {
+        if (id < 0 || id >= count)
+        {
+            throw std::invalid_argument(std::string("Instance edits refer to ") + what + " " + std::to_string(id) + ", out of the instance");
+        }
+    }
+
+    void ScpEdits::validate(int elementCount, int subsetCount) const
+    {
+        int newElementCount = elementCount + static_cast<int>(addedRows.size());
+        int newSubsetCount = subsetCount + static_cast<int>(addedColumns.size());
+        for (const ScpColumn &column : addedColumns)
+        {
+            for (int element : column.elements)
+            {
+                checkId(element, newElementCount, "element");
+            }
+        }
+        for (const std::vector<int> &row : addedRows)
+        {
+            if (row.empty())
+            {
+                throw std::invalid_argument("Instance edits add an element no subset contains");
+            }
+            for (int subset : row)
+            {
+                checkId(subset, newSubsetCount, "subset");
+            }
+        }
+        for (const auto &[subset, cost] : costChanges)
+        {
+            checkId(subset, newSubsetCount, "subset");
+        }
+        for (int subset : removedColumns)
+        {
+            checkId(subset, newSubsetCount, "subset");
+        }
+    }
+
+    void ScpEdits::applyTo(ScpInput &input) const
+    {
+        validate(input.elementCount, input.subsetCount);
+
+        std::vector<std::unordered_set<int>> relations = input.relations;
+        std::vector<int> costs = input.costs;
+        relations.resize(input.elementCount + addedRows.size());
+        for (size_t i = 0; i < addedColumns.size(); ++i)
+        {
+            costs.push_back(addedColumns[i].cost);
+            for (int element : addedColumns[i].elements)
+            {
+                relations[element].insert(input.subsetCount + static_cast<int>(i));
+            }
+        }
+        for (size_t i = 0; i < addedRows.size(); ++i)
+        {
+            relations[input.elementCount + i].insert(addedRows[i].begin(), addedRows[i].end());
+        }
+        for (const auto &[subset, cost] : costChanges)
+        {
+            costs[subset] = cost;
+        }
+        for (int subset : removedColumns)
+        {
+            for (std::unordered_set<int> &relation : relations)
+            {
+                relation.erase(subset);
+            }
+        }
+
+        for (size_t element = 0; element < relations.size(); ++element)
+        {
+            if (relations[element].empty())
+            {
+                throw std::invalid_argument("Instance edits leave element " + std::to_string(element) + " in no subset");
+            }
+        }
+
+        input.elementCount = static_cast<int>(relations.size());
+        input.subsetCount = static_cast<int>(costs.size());
+        input.costs = std::move(costs);
+        input.relations = std::move(relations);
+    }
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "util/Data.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace Heuro
+{
+
+    struct ScpColumn
+    {
+        int cost = 0;
+        std::vector<int> elements; // The elements the subset contains
+    };
+
+    /**
+     * @brief A batch of changes to an SCP instance, applied in the order of the fields: columns are added first, then rows,
+     * then costs change and columns are removed. Every ID refers to the instance once the columns and rows are added.
+     * Subset IDs never change: added columns take the IDs after the last one, and removed columns keep theirs but cover
+     * no element anymore, so solutions of the instance before the edits stay meaningful after them.
+     */
+    struct ScpEdits
+    {
+        std::vector<ScpColumn> addedColumns; // Take the subset IDs n, n + 1, ...
+        std::vector<std::vector<int>> addedRows; // Take the element IDs m, m + 1, ...; each lists the subsets that contain it
+        std::vector<std::pair<int, int>> costChanges; // Subset ID and its new cost
+        std::vector<int> removedColumns;
+
+        bool empty() const { return addedColumns.empty() && addedRows.empty() && costChanges.empty() && removedColumns.empty(); }
+
+        /**
+         * @brief Checks that every ID exists in an instance of the given size once the edits add to it, and that every added
+         * row is contained by some subset.
+         *
+         * @throws std::invalid_argument If not.
+         */
+        void validate(int elementCount, int subsetCount) const;
+
+        /**
+         * @throws std::invalid_argument If the edits are invalid for the input, or leave an element in no subset.
+         */
+        void applyTo(ScpInput &input) const;
+    };
+
+}
@@ -0,0 +1,239 @@
+#include "ScpGenerator.hpp"
+
+#include "Bitset.hpp"
+#include "RandomIntGenerator.hpp"
+#include "RandomSeed.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Lays numbers out like the OR-Library files, 12 per line, and hands them to the stream in large blocks, which is
+     * several times faster than formatting them through the stream.
+     */
+    class OrLibraryWriter
+    {
+    private:
+        static constexpr int NUMBERS_PER_LINE = 12;
+        static constexpr size_t BLOCK_SIZE = size_t(1) << 20;
+
+        std::ostream &m_Output;
+        std::string m_Buffer;
+        int m_LineLength = 0;
+
+    public:
+        explicit OrLibraryWriter(std::ostream &os)
+            : m_Output(os)
+        {
+            m_Buffer.reserve(BLOCK_SIZE + 64);
+        }
+
+        ~OrLibraryWriter() { flush(); }
+
+        void add(int value)
+        {
+            char digits[16];
+            char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+            m_Buffer += ' ';
+            m_Buffer.append(digits, end);
+            if (++m_LineLength == NUMBERS_PER_LINE)
+            {
+                endLine();
+            }
+        }
+
+        void endLine()
+        {
+            if (m_LineLength == 0)
+            {
+                return;
+            }
+            m_Buffer += " \n";
+            m_LineLength = 0;
+            if (m_Buffer.size() >= BLOCK_SIZE)
+            {
+                flush();
+            }
+        }
+
+        void flush()
+        {
+            m_Output.write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+            m_Buffer.clear();
+        }
+    };
+
+    // adds random columns to the row until minCoverage of them cover it, marked holding the columns already in the row
+    static void topUpCoverage(std::vector<int> &row, Bitset &marked, int minCoverage, RandomIntGenerator &columnGen)
+    {
+        while (static_cast<int>(row.size()) < minCoverage)
+        {
+            int column = columnGen();
+            if (!marked.test(column))
+            {
+                marked.set(column);
+                row.push_back(column);
+            }
+        }
+    }
+
+    static void writeRow(OrLibraryWriter &writer, std::vector<int> &row, Bitset &marked)
+    {
+        std::sort(row.begin(), row.end());
+        writer.add(static_cast<int>(row.size()));
+        writer.endLine();
+        for (int column : row)
+        {
+            writer.add(column + 1);
+            marked.reset(column);
+        }
+        writer.endLine();
+        row.clear();
+    }
+
+    // every row takes about density * n random columns, after the columns j with j = i + offset (mod m), which make sure
+    // every column covers some row
+    static void writeBeasleyRows(const ScpGeneratorOptions &options, OrLibraryWriter &writer)
+    {
+        const int m = options.rowCount;
+        const int n = options.columnCount;
+        double expectedCoverage = options.density * n;
+        int minCount = std::max(1, static_cast<int>(std::lround(0.5 * expectedCoverage)));
+        int maxCount = std::max(minCount, static_cast<int>(std::lround(1.5 * expectedCoverage)));
+
+        RandomIntGenerator columnGen(0, n);
+        RandomIntGenerator countGen(minCount, maxCount + 1);
+        int offset = RandomIntGenerator(0, m)();
+        Bitset marked(n);
+        std::vector<int> row;
+        for (int i = 0; i < m; ++i)
+        {
+            for (int column = (i + offset) % m; column < n; column += m)
+            {
+                marked.set(column);
+                row.push_back(column);
+            }
+            int count = std::min(n, std::max({ countGen(), options.minCoverage, static_cast<int>(row.size()) }));
+            topUpCoverage(row, marked, count, columnGen);
+            writeRow(writer, row, marked);
+        }
+    }
+
+    // the columns start at evenly spread rows in order, column j at row j * m / n, and cover a random number of rows from
+    // there, so the columns of a row are the ones that started at most maxColumnRows rows before it and have not ended yet
+    static void writeRailRows(const ScpGeneratorOptions &options, const std::vector<uint8_t> &columnRows, OrLibraryWriter &writer)
+    {
+        const int m = options.rowCount;
+        const int n = options.columnCount;
+        auto start = [m, n](int column) { return static_cast<int>(static_cast<int64_t>(column) * m / n); };
+
+        RandomIntGenerator columnGen(0, n);
+        Bitset marked(n);
+        std::vector<int> row;
+        int firstColumn = 0;
+        int endColumn = 0;
+        for (int i = 0; i < m; ++i)
+        {
+            while (endColumn < n && start(endColumn) <= i)
+            {
+                endColumn += 1;
+            }
+            while (firstColumn < endColumn && start(firstColumn) + options.maxColumnRows <= i)
+            {
+                firstColumn += 1;
+            }
+            for (int column = firstColumn; column < endColumn; ++column)
+            {
+                if (start(column) + columnRows[column] > i)
+                {
+                    marked.set(column);
+                    row.push_back(column);
+                }
+            }
+            topUpCoverage(row, marked, options.minCoverage, columnGen);
+            writeRow(writer, row, marked);
+        }
+    }
+
+    void ScpGeneratorOptions::validate() const
+    {
+        if (rowCount < 1 || columnCount < 1)
+        {
+            throw std::invalid_argument("An instance needs at least one row and one column");
+        }
+        if (minCoverage < 1 || minCoverage > columnCount)
+        {
+            throw std::invalid_argument("The minimum coverage must be between 1 and the column count");
+        }
+        if (minCost < 0 || minCost > maxCost)
+        {
+            throw std::invalid_argument("The costs must be non-negative, with minCost <= maxCost");
+        }
+        if (style == Style::Beasley && !(density > 0.0 && density <= 1.0))
+        {
+            throw std::invalid_argument("The density must be in (0, 1]");
+        }
+        if (style == Style::Rail && (maxColumnRows < 1 || maxColumnRows > 255))
+        {
+            throw std::invalid_argument("The rows per column must be between 1 and 255");
+        }
+    }
+
+    void ScpGenerator::write(const ScpGeneratorOptions &options, std::ostream &os)
+    {
+        options.validate();
+        RandomSeed::Scope seed(options.seed);
+
+        OrLibraryWriter writer(os);
+        writer.add(options.rowCount);
+        writer.add(options.columnCount);
+        writer.endLine();
+
+        RandomIntGenerator costGen(options.minCost, options.maxCost + 1);
+        for (int column = 0; column < options.columnCount; ++column)
+        {
+            writer.add(costGen());
+        }
+        writer.endLine();
+
+        if (options.style == ScpGeneratorOptions::Style::Beasley)
+        {
+            writeBeasleyRows(options, writer);
+        }
+        else
+        {
+            RandomIntGenerator rowsGen(1, options.maxColumnRows + 1);
+            std::vector<uint8_t> columnRows(options.columnCount);
+            for (uint8_t &rows : columnRows)
+            {
+                rows = static_cast<uint8_t>(rowsGen());
+            }
+            writeRailRows(options, columnRows, writer);
+        }
+    }
+
+    void ScpGenerator::writeFile(const ScpGeneratorOptions &options, const std::string &filename)
+    {
+        options.validate();
+        std::ofstream file(filename, std::ios::trunc | std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Can not open " + filename + " for writing");
+        }
+
+        write(options, file);
+        file.flush();
+        if (!file)
+        {
+            throw std::runtime_error("Could not write " + filename);
+        }
+    }
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Shape of a synthetic SCP instance.
+     */
+    struct ScpGeneratorOptions
+    {
+        enum class Style
+        {
+            Beasley, // Every row picks its columns uniformly, like the OR-Library scp4* to scpnrh* sets
+            Rail, // Every column covers a run of consecutive rows, like the crew scheduling rail* sets
+        };
+
+        Style style = Style::Beasley;
+        int rowCount = 200;
+        int columnCount = 1000;
+        double density = 0.02; // Beasley: average fraction of the columns that cover a row
+        int maxColumnRows = 10; // Rail: every column covers between 1 and this many consecutive rows, at most 255
+        int minCost = 1;
+        int maxCost = 100; // Costs are uniform in [minCost, maxCost], equal bounds give a unicost instance
+        int minCoverage = 2; // Columns that cover every row at least
+        uint64_t seed = 1;
+
+        /**
+         * @throws std::invalid_argument If the options do not describe a valid instance.
+         */
+        void validate() const;
+    };
+
+    /**
+     * @brief Writes synthetic instances in the OR-Library format read by ScpParser one row at a time, so the memory used
+     * does not grow with the size of the file: a bit per column for Beasley instances, a byte per column for rail ones,
+     * and the columns of the current row.
+     * Every column covers at least one row, every row is covered by at least minCoverage columns, and the same options always
+     * give the same file.
+     */
+    class ScpGenerator
+    {
+    public:
+        /**
+         * @throws std::invalid_argument If the options are invalid.
+         */
+        static void write(const ScpGeneratorOptions &options, std::ostream &os);
+
+        /**
+         * @throws std::invalid_argument If the options are invalid.
+         * @throws std::runtime_error If the file can not be written.
+         */
+        static void writeFile(const ScpGeneratorOptions &options, const std::string &filename);
+    };
+
+}
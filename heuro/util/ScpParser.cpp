@@ -1,6 +1,7 @@
 #include "ScpParser.hpp"
 
 #include <fstream>
+#include <stdexcept>
 #include <utility>
 
 namespace Heuro
@@ -9,32 +10,53 @@ namespace Heuro
     ScpInput ScpParser::parseFile(const std::string &filename)
     {
         std::ifstream inputFile(filename);
-        int m, n;
-        std::vector<int> costs;
-        std::vector<std::unordered_set<int>> relations;
+        if (!inputFile.is_open())
+        {
+            throw std::runtime_error("Could not open instance " + filename);
+        }
+
+        // every value is an integer, and a truncated file fails the read of the first one missing
+        auto readInt = [&inputFile, &filename](const char *what)
+        {
+            int value;
+            if (!(inputFile >> value))
+            {
+                throw std::runtime_error("Instance " + filename + " is missing " + what);
+            }
+            return value;
+        };
 
-        bool test = inputFile.is_open();
-        inputFile >> m;
-        inputFile >> n;
+        int m = readInt("its element count");
+        int n = readInt("its subset count");
+        if (m <= 0 || n <= 0)
+        {
+            throw std::runtime_error("Instance " + filename + " has no elements or no subsets");
+        }
 
+        std::vector<int> costs;
         costs.reserve(n);
         for (int i = 0; i < n; ++i)
         {
-            int cost;
-            inputFile >> cost;
-            costs.push_back(cost);
+            costs.push_back(readInt("a subset cost"));
         }
 
+        std::vector<std::unordered_set<int>> relations;
         relations.reserve(m);
         for (int i = 0; i < m; ++i)
         {
-            int numOfSubsets;
-            inputFile >> numOfSubsets;
+            int numOfSubsets = readInt("the subset count of an element");
+            if (numOfSubsets < 0 || numOfSubsets > n)
+            {
+                throw std::runtime_error("Instance " + filename + " has an invalid subset count for element " + std::to_string(i + 1));
+            }
             std::unordered_set<int> relation(numOfSubsets);
             for (int j = 0; j < numOfSubsets; ++j)
             {
-                int subset;
-                inputFile >> subset;
+                int subset = readInt("a subset of an element");
+                if (subset < 1 || subset > n)
+                {
+                    throw std::runtime_error("Instance " + filename + " has subset " + std::to_string(subset) + ", outside 1.." + std::to_string(n));
+                }
                 relation.insert(subset - 1);
             }
             relations.push_back(std::move(relation));
@@ -43,4 +65,4 @@ namespace Heuro
         return ScpInput{ m, n, std::move(costs), std::move(relations) };
     }
 
-}
\ No newline at end of file
+}
@@ -10,6 +10,11 @@ namespace Heuro
     class ScpParser
     {
     public:
+        /**
+         * @brief Reads an instance in the OR-Library format.
+         *
+         * @throws std::runtime_error If the file can not be opened, is truncated or holds values out of range.
+         */
         static ScpInput parseFile(const std::string &filename);
     };
 
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Data.hpp"
+#include "ZobristHash.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief A drop/add move over a solution. An added value of -1 means the move only drops a subset.
+     */
+    struct ScpMove
+    {
+        int removed = -1;
+        int added = -1;
+    };
+
+    /**
+     * @brief Working representation of an SCP solution used internally by the solvers.
+     * It keeps a dense list of the selected subsets together with the position of each one (O(1) add/remove),
+     * the cached cost, its Zobrist hash, and how many selected subsets cover each element, so feasibility is known at all times.
+     * All storage is sized once for the instance, so copying into an existing solution or editing it in place
+     * does not allocate.
+     *
+     * @tparam Index The type of the subset IDs, positions and coverage counters (see ScpTraits).
+     */
+    template<typename Index>
+    class BasicScpSolution
+    {
+    private:
+        static constexpr Index NOT_SELECTED = std::numeric_limits<Index>::max();
+
+        std::vector<Index> m_Subsets; // Dense list of the selected subset IDs
+        std::vector<Index> m_Positions; // Index of each subset within m_Subsets, or NOT_SELECTED
+        std::vector<Index> m_Coverage; // Amount of selected subsets that contain each element
+        int m_UncoveredCount = 0;
+        int m_Cost = 0;
+        uint64_t m_Hash = 0; // Zobrist hash of the selected subsets
+
+    public:
+        BasicScpSolution() = default;
+
+        BasicScpSolution(int elementCount, int subsetCount)
+            : m_Positions(subsetCount, NOT_SELECTED), m_Coverage(elementCount, 0), m_UncoveredCount(elementCount)
+        {
+            m_Subsets.reserve(subsetCount);
+        }
+
+        bool contains(int subset) const { return m_Positions[subset] != NOT_SELECTED; }
+        bool isFeasible() const { return m_UncoveredCount == 0; }
+        int cost() const { return m_Cost; }
+        uint64_t hash() const { return m_Hash; }
+        size_t size() const { return m_Subsets.size(); }
+        int uncoveredCount() const { return m_UncoveredCount; }
+        int coverage(int element) const { return m_Coverage[element]; }
+        const std::vector<Index> &subsets() const { return m_Subsets; }
+
+        /**
+         * @brief Selects a subset. Does nothing if it is already selected.
+         *
+         * @param subset The subset ID.
+         * @param cost The cost of the subset.
+         * @param elements The elements contained by the subset.
+         */
+        void add(int subset, int cost, const std::vector<Index> &elements)
+        {
+            if (contains(subset))
+            {
+                return;
+            }
+
+            m_Positions[subset] = static_cast<Index>(m_Subsets.size());
+            m_Subsets.push_back(static_cast<Index>(subset));
+            m_Cost += cost;
+            m_Hash ^= ZobristHash::key(subset);
+            for (Index element : elements)
+            {
+                if (m_Coverage[element]++ == 0)
+                {
+                    m_UncoveredCount -= 1;
+                }
+            }
+        }
+
+        /**
+         * @brief Deselects a subset. Does nothing if it is not selected.
+         *
+         * @param subset The subset ID.
+         * @param cost The cost of the subset.
+         * @param elements The elements contained by the subset.
+         */
+        void remove(int subset, int cost, const std::vector<Index> &elements)
+        {
+            if (!contains(subset))
+            {
+                return;
+            }
+
+            Index position = m_Positions[subset];
+            Index last = m_Subsets.back();
+            m_Subsets[position] = last;
+            m_Positions[last] = position;
+            m_Subsets.pop_back();
+            m_Positions[subset] = NOT_SELECTED;
+
+            m_Cost -= cost;
+            m_Hash ^= ZobristHash::key(subset);
+            for (Index element : elements)
+            {
+                if (--m_Coverage[element] == 0)
+                {
+                    m_UncoveredCount += 1;
+                }
+            }
+        }
+
+        /**
+         * @brief Checks whether a subset contains every element that is currently uncovered, i.e. whether adding it would make
+         * the solution feasible. Does not modify the solution.
+         */
+        bool coversAllUncovered(const std::vector<Index> &elements) const
+        {
+            int newlyCovered = 0;
+            for (Index element : elements)
+            {
+                if (m_Coverage[element] == 0)
+                {
+                    newlyCovered += 1;
+                }
+            }
+            return newlyCovered == m_UncoveredCount;
+        }
+
+        /**
+         * @brief Deselects every subset, keeping the allocated storage.
+         */
+        void clear()
+        {
+            for (Index subset : m_Subsets)
+            {
+                m_Positions[subset] = NOT_SELECTED;
+            }
+            m_Subsets.clear();
+            std::fill(m_Coverage.begin(), m_Coverage.end(), 0);
+            m_UncoveredCount = static_cast<int>(m_Coverage.size());
+            m_Cost = 0;
+            m_Hash = 0;
+        }
+
+        ScpResult toResult() const
+        {
+            return { m_Cost, m_Subsets.size(), std::unordered_set<int>(m_Subsets.begin(), m_Subsets.end()) };
+        }
+    };
+
+}
@@ -0,0 +1,85 @@
+#include "ScpSolutionFile.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Heuro
+{
+
+    std::vector<ScpResult> ScpSolutionFile::read(const std::string &filename)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Can not open solution file " + filename);
+        }
+
+        std::vector<ScpResult> solutions;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line))
+        {
+            lineNumber += 1;
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream values(line);
+            ScpResult solution;
+            std::vector<int> subsets;
+            int subset;
+            bool isValid = static_cast<bool>(values >> solution.cost >> solution.subsetCount);
+            while (values >> subset)
+            {
+                subsets.push_back(subset);
+            }
+            isValid = isValid && values.eof() && subsets.size() == solution.subsetCount
+                && std::all_of(subsets.begin(), subsets.end(), [](int id) { return id >= 1; });
+            if (!isValid)
+            {
+                throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": expected the cost, the subset count and that many subset IDs");
+            }
+
+            for (int id : subsets)
+            {
+                solution.subsetIDs.insert(id - 1);
+            }
+            solution.subsetCount = solution.subsetIDs.size();
+            solutions.push_back(std::move(solution));
+        }
+
+        return solutions;
+    }
+
+    void ScpSolutionFile::write(const std::string &filename, const std::vector<ScpResult> &solutions)
+    {
+        std::ofstream file(filename, std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Can not write solution file " + filename);
+        }
+
+        file << "# cost, subset count, subset IDs\n";
+        for (const ScpResult &solution : solutions)
+        {
+            std::vector<int> subsets(solution.subsetIDs.begin(), solution.subsetIDs.end());
+            std::sort(subsets.begin(), subsets.end());
+            file << solution.cost << ' ' << subsets.size();
+            for (int subset : subsets)
+            {
+                file << ' ' << subset + 1;
+            }
+            file << '\n';
+        }
+
+        if (!file.flush())
+        {
+            throw std::runtime_error("Can not write solution file " + filename);
+        }
+    }
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "util/Data.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Reads and writes solution files, which hold one solution per line in the layout of ScpResult::toVec: the cost,
+     * the subset count and the subset IDs, 1-based like in the instance files. Blank lines and lines starting with '#' are
+     * skipped.
+     */
+    class ScpSolutionFile
+    {
+    public:
+        /**
+         * @throws std::runtime_error If the file can not be read or a line is malformed.
+         */
+        static std::vector<ScpResult> read(const std::string &filename);
+
+        /**
+         * @brief Writes the solutions with their subset IDs sorted, replacing the file.
+         *
+         * @throws std::runtime_error If the file can not be written.
+         */
+        static void write(const std::string &filename, const std::vector<ScpResult> &solutions);
+    };
+
+}
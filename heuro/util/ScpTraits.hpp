@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Cost type of unicost instances, where every subset costs 1 and no costs are stored.
+     */
+    struct UnitCost
+    {
+    };
+
+    /**
+     * @brief The cost of each subset, stored in the narrowest type that fits the instance. Costs are read back as int.
+     */
+    template<typename Cost>
+    class CostTable
+    {
+    private:
+        std::vector<Cost> m_Costs;
+
+    public:
+        CostTable() = default;
+
+        explicit CostTable(const std::vector<int> &costs)
+            : m_Costs(costs.begin(), costs.end())
+        {
+        }
+
+        int operator[](size_t subset) const { return static_cast<int>(m_Costs[subset]); }
+        size_t size() const { return m_Costs.size(); }
+
+        static bool fits(int cost)
+        {
+            return cost >= std::numeric_limits<Cost>::min() && cost <= std::numeric_limits<Cost>::max();
+        }
+
+        void set(size_t subset, int cost) { m_Costs[subset] = static_cast<Cost>(cost); }
+        void push_back(int cost) { m_Costs.push_back(static_cast<Cost>(cost)); }
+    };
+
+    template<>
+    class CostTable<UnitCost>
+    {
+    private:
+        size_t m_Size = 0;
+
+    public:
+        CostTable() = default;
+
+        explicit CostTable(const std::vector<int> &costs)
+            : m_Size(costs.size())
+        {
+        }
+
+        int operator[](size_t) const { return 1; }
+        size_t size() const { return m_Size; }
+
+        static bool fits(int cost) { return cost == 1; }
+
+        void set(size_t, int) {}
+        void push_back(int) { m_Size += 1; }
+    };
+
+    /**
+     * @brief Compile-time description of the representation of an instance inside the solvers.
+     *
+     * @tparam IndexT The type of element and subset IDs, and of the coverage counters.
+     * @tparam CostT The type in which subset costs are stored, or UnitCost for unicost instances.
+     */
+    template<typename IndexT, typename CostT>
+    struct ScpTraits
+    {
+        static_assert(std::is_unsigned_v<IndexT>, "Indices are unsigned, with their maximum value reserved");
+
+        using Index = IndexT;
+        using Cost = CostT;
+
+        static constexpr bool UNICOST = std::is_same_v<Cost, UnitCost>;
+
+        /**
+         * @brief Whether an instance of the given size can be represented. The maximum index value is kept as a sentinel.
+         */
+        static constexpr bool fitsSize(int elementCount, int subsetCount)
+        {
+            constexpr long long maxCount = std::numeric_limits<Index>::max();
+            return elementCount < maxCount && subsetCount < maxCount;
+        }
+
+        static std::string name()
+        {
+            std::string cost;
+            if constexpr (UNICOST)
+            {
+                cost = "unit";
+            }
+            else
+            {
+                cost = (std::is_signed_v<Cost> ? "i" : "u") + std::to_string(8 * sizeof(Cost));
+            }
+            return "u" + std::to_string(8 * sizeof(Index)) + "/" + cost;
+        }
+    };
+
+    // The specializations built into the library, see ScpSolver::create
+    using ScpTraitsU16 = ScpTraits<uint16_t, uint16_t>;
+    using ScpTraitsU16Wide = ScpTraits<uint16_t, int32_t>;
+    using ScpTraitsU16Unicost = ScpTraits<uint16_t, UnitCost>;
+    using ScpTraitsU32 = ScpTraits<uint32_t, uint16_t>;
+    using ScpTraitsU32Wide = ScpTraits<uint32_t, int32_t>;
+    using ScpTraitsU32Unicost = ScpTraits<uint32_t, UnitCost>;
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Bitset.hpp"
+#include "RandomBinaryGenerator.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace Heuro
+{
+
+    namespace Util
+    {
+        inline Bitset genRandomBitset(size_t size, double probability)
+        {
+            Bitset bits(size);
+            RandomBinaryGenerator gen(probability);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (gen())
+                {
+                    bits.set(i);
+                }
+            }
+
+            return bits;
+        }
+
+        template<typename Index>
+        Bitset vecToBitset(const std::vector<Index> &values, size_t size)
+        {
+            Bitset bits(size);
+            for (Index value : values)
+            {
+                bits.set(value);
+            }
+
+            return bits;
+        }
+
+        inline std::unordered_set<int> bitsetToSet(const Bitset &bits)
+        {
+            std::unordered_set<int> set;
+            set.reserve(bits.count());
+            bits.forEachSetBit([&set](size_t i) { set.insert(static_cast<int>(i)); });
+
+            return set;
+        }
+
+        inline std::vector<int> bitsetToVec(const Bitset &bits)
+        {
+            std::vector<int> vec;
+            vec.reserve(bits.count());
+            bits.forEachSetBit([&vec](size_t i) { vec.push_back(static_cast<int>(i)); });
+
+            return vec;
+        }
+    }
+
+}
@@ -0,0 +1,61 @@
+#include "ScratchArena.hpp"
+
+#include <algorithm>
+
+namespace Heuro
+{
+
+    CountingMemoryResource::CountingMemoryResource(std::pmr::memory_resource *upstream)
+        : m_Upstream(upstream)
+    {
+    }
+
+    void CountingMemoryResource::resetStats()
+    {
+        m_Stats = { 0, 0, m_CurrentBytes };
+    }
+
+    void *CountingMemoryResource::do_allocate(size_t bytes, size_t alignment)
+    {
+        void *p = m_Upstream->allocate(bytes, alignment);
+        m_Stats.allocationCount += 1;
+        m_Stats.allocatedBytes += bytes;
+        m_LifetimeBytes += bytes;
+        m_CurrentBytes += bytes;
+        m_Stats.peakBytes = std::max(m_Stats.peakBytes, m_CurrentBytes);
+        return p;
+    }
+
+    void CountingMemoryResource::do_deallocate(void *p, size_t bytes, size_t alignment)
+    {
+        m_Upstream->deallocate(p, bytes, alignment);
+        m_CurrentBytes -= bytes;
+    }
+
+    bool CountingMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
+    ScratchArena::ScratchArena(size_t initialBytes, std::pmr::memory_resource *upstream)
+        : m_Upstream(upstream), m_Buffer(std::max<size_t>(initialBytes, 1), &m_Upstream)
+    {
+        m_Resource.emplace(m_Buffer.data(), m_Buffer.size(), &m_Upstream);
+        m_OverflowMark = m_Upstream.lifetimeBytes();
+    }
+
+    void ScratchArena::reset()
+    {
+        // not the stats, which the caller may reset in the middle of an iteration
+        size_t overflowBytes = m_Upstream.lifetimeBytes() - m_OverflowMark;
+        m_Resource->release();
+        if (overflowBytes > 0)
+        {
+            m_Resource.reset();
+            m_Buffer.assign(m_Buffer.size() + overflowBytes, std::byte{ 0 });
+            m_Resource.emplace(m_Buffer.data(), m_Buffer.size(), &m_Upstream);
+        }
+        m_OverflowMark = m_Upstream.lifetimeBytes();
+    }
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace Heuro
+{
+
+    struct MemoryStats
+    {
+        size_t allocationCount = 0; // Allocations that reached the upstream resource
+        size_t allocatedBytes = 0; // Total bytes requested from the upstream resource
+        size_t peakBytes = 0; // Highest amount of bytes held from the upstream resource at once
+    };
+
+    /**
+     * @brief Memory resource that forwards to an upstream resource while counting allocations and tracking peak usage.
+     */
+    class CountingMemoryResource : public std::pmr::memory_resource
+    {
+    private:
+        std::pmr::memory_resource *m_Upstream;
+        MemoryStats m_Stats;
+        size_t m_CurrentBytes = 0;
+        size_t m_LifetimeBytes = 0; // Same as m_Stats.allocatedBytes, but never reset
+
+    public:
+        explicit CountingMemoryResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+        const MemoryStats &stats() const { return m_Stats; }
+        void resetStats();
+
+        /**
+         * @brief Total bytes requested from the upstream resource since construction, which resetStats() leaves alone.
+         */
+        size_t lifetimeBytes() const { return m_LifetimeBytes; }
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    /**
+     * @brief Per-solver scratch memory. It hands out memory from a monotonic buffer that is released wholesale with reset(),
+     * typically once per algorithm iteration. The initial buffer grows to the largest iteration seen so far, so in steady
+     * state no iteration reaches the upstream resource.
+     */
+    class ScratchArena
+    {
+    private:
+        CountingMemoryResource m_Upstream;
+        std::pmr::vector<std::byte> m_Buffer;
+        std::optional<std::pmr::monotonic_buffer_resource> m_Resource;
+        size_t m_OverflowMark = 0; // Upstream lifetime bytes when the current iteration started
+
+    public:
+        explicit ScratchArena(size_t initialBytes, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+        ScratchArena(const ScratchArena &) = delete;
+        ScratchArena &operator=(const ScratchArena &) = delete;
+
+        std::pmr::memory_resource *resource() { return &*m_Resource; }
+
+        /**
+         * @brief Releases everything allocated since the last reset. If the iteration overflowed the buffer, the buffer is
+         * enlarged so the next one fits.
+         */
+        void reset();
+
+        /**
+         * @brief The statistics of the memory taken from the upstream resource, including the arena buffer itself.
+         */
+        const MemoryStats &stats() const { return m_Upstream.stats(); }
+        void resetStats() { m_Upstream.resetStats(); }
+    };
+
+}
@@ -3,10 +3,10 @@
 namespace Heuro
 {
 
-    Timer::Timer(long maxDurationMillis)
+    Timer::Timer(long maxDurationMillis, long elapsedMillis)
         : m_MaxDurationMillis(maxDurationMillis), m_Stopped(false)
     {
-        m_StartTimePoint = std::chrono::steady_clock::now();
+        m_StartTimePoint = std::chrono::steady_clock::now() - std::chrono::milliseconds(elapsedMillis);
     }
 
     void Timer::tick()
@@ -19,6 +19,11 @@ namespace Heuro
         checkIfDone(elapsedTime.count());
     }
 
+    long Timer::elapsedMillis() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_StartTimePoint).count();
+    }
+
     bool Timer::hasStopped() const
     {
         return m_Stopped;
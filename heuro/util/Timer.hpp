@@ -15,9 +15,13 @@ namespace Heuro
         void checkIfDone(long elapsedMillis);
 
     public:
-        explicit Timer(long maxDurationMillis);
+        /**
+         * @param elapsedMillis Time already spent, e.g. by the run a checkpoint was taken from.
+         */
+        explicit Timer(long maxDurationMillis, long elapsedMillis = 0);
 
         void tick();
+        long elapsedMillis() const;
         bool hasStopped() const;
     };
 
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Winner tree over the keys of a set of items, used as a restricted candidate list: items are removed and rekeyed
+     * in O(log n), and the k items with the smallest keys are listed in O(k log n) without touching the rest.
+     * Every node holds the key of its winner next to it, so a match only reads the two sibling nodes.
+     * Ties are broken by the lower item index, so the order is deterministic.
+     *
+     * @tparam Key The type of the keys, compared with operator<.
+     */
+    template<typename Key>
+    class TournamentTree
+    {
+    private:
+        static constexpr int NONE = -1;
+
+        struct Node
+        {
+            Key key{};
+            int item = NONE; // Item with the smallest key below the node, or NONE
+        };
+
+        size_t m_LeafCount = 0; // Power of two, item i is the leaf m_LeafCount + i
+        int m_Size = 0;
+        std::pmr::vector<Node> m_Nodes; // Root at 1
+        std::pmr::vector<int> m_Frontier; // Heap of the subtrees left to list in smallest()
+        std::pmr::vector<int> m_Refreshed; // Nodes below which smallest() refreshed an item
+
+        static bool less(const Node &first, const Node &second)
+        {
+            if (first.item == NONE || second.item == NONE)
+            {
+                return second.item == NONE && first.item != NONE;
+            }
+            return first.key < second.key || (!(second.key < first.key) && first.item < second.item);
+        }
+
+        void playMatch(size_t node)
+        {
+            const Node &left = m_Nodes[2 * node];
+            const Node &right = m_Nodes[2 * node + 1];
+            m_Nodes[node] = less(right, left) ? right : left;
+        }
+
+        // replays the matches on the path from the given node up to, and including, the given ancestor. Once a match keeps
+        // its winner, the ones above it keep theirs too, so the replay stops there
+        void replay(size_t node, size_t ancestor)
+        {
+            for (node /= 2; node >= ancestor && node > 0; node /= 2)
+            {
+                Node previous = m_Nodes[node];
+                playMatch(node);
+                const Node &current = m_Nodes[node];
+                if (previous.item == current.item && !(previous.key < current.key) && !(current.key < previous.key))
+                {
+                    return;
+                }
+            }
+        }
+
+    public:
+        explicit TournamentTree(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : m_Nodes(resource), m_Frontier(resource), m_Refreshed(resource)
+        {
+        }
+
+        /**
+         * @brief Makes the tree hold the items 0 to keys.size() - 1 with the given keys, in O(n).
+         */
+        void assign(std::span<const Key> keys)
+        {
+            m_LeafCount = std::bit_ceil(std::max<size_t>(keys.size(), 1));
+            m_Size = static_cast<int>(keys.size());
+            m_Nodes.assign(2 * m_LeafCount, Node{});
+            for (size_t item = 0; item < keys.size(); ++item)
+            {
+                m_Nodes[m_LeafCount + item] = { keys[item], static_cast<int>(item) };
+            }
+            for (size_t node = m_LeafCount - 1; node > 0; --node)
+            {
+                playMatch(node);
+            }
+        }
+
+        int size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+        bool contains(int item) const { return m_Nodes[m_LeafCount + item].item != NONE; }
+        Key key(int item) const { return m_Nodes[m_LeafCount + item].key; }
+
+        /**
+         * @brief Changes the key of an item, putting it back in the tree if it had been removed.
+         */
+        void update(int item, Key key)
+        {
+            size_t leaf = m_LeafCount + item;
+            m_Size += m_Nodes[leaf].item == NONE;
+            m_Nodes[leaf] = { key, item };
+            replay(leaf, 1);
+        }
+
+        void remove(int item)
+        {
+            size_t leaf = m_LeafCount + item;
+            if (m_Nodes[leaf].item == NONE)
+            {
+                return;
+            }
+            --m_Size;
+            m_Nodes[leaf].item = NONE;
+            replay(leaf, 1);
+        }
+
+        /**
+         * @brief Leaves in items the (at most) k items with the smallest keys, in increasing order of key.
+         */
+        void smallest(size_t k, std::pmr::vector<int> &items)
+        {
+            smallest(k, items, [this](int item) -> std::optional<Key> { return key(item); });
+        }
+
+        /**
+         * @brief Same as smallest(k, items), for keys that are kept up to date lazily: refresh(item) is asked for the current
+         * key of every item as it comes up, or std::nullopt if the item is gone, and the item is moved or removed before it
+         * can be listed. Keys may only grow, so an item whose key is stale is never listed too early.
+         * Every listed item walks down to its leaf pushing the subtrees hanging off its path, which hold the next candidates.
+         * A refreshed item only changes the subtree it was popped with, which goes back into the frontier, and the matches
+         * above it are replayed once the listing is done.
+         */
+        template<typename Refresh>
+        void smallest(size_t k, std::pmr::vector<int> &items, Refresh &&refresh)
+        {
+            items.clear();
+            m_Frontier.clear();
+            m_Refreshed.clear();
+            auto heapOrder = [this](int first, int second) { return less(m_Nodes[second], m_Nodes[first]); };
+            auto pushFrontier = [this, &heapOrder](size_t node)
+            {
+                m_Frontier.push_back(static_cast<int>(node));
+                std::push_heap(m_Frontier.begin(), m_Frontier.end(), heapOrder);
+            };
+            if (m_Nodes[1].item != NONE)
+            {
+                m_Frontier.push_back(1);
+            }
+
+            while (items.size() < k && !m_Frontier.empty())
+            {
+                std::pop_heap(m_Frontier.begin(), m_Frontier.end(), heapOrder);
+                size_t node = m_Frontier.back();
+                m_Frontier.pop_back();
+
+                int item = m_Nodes[node].item;
+                Node &leaf = m_Nodes[m_LeafCount + item];
+                std::optional<Key> key = refresh(item);
+                if (!key || leaf.key < *key)
+                {
+                    if (key)
+                    {
+                        leaf.key = *key;
+                    }
+                    else
+                    {
+                        leaf.item = NONE;
+                        --m_Size;
+                    }
+                    replay(m_LeafCount + item, node);
+                    if (m_Nodes[node].item != NONE)
+                    {
+                        pushFrontier(node);
+                    }
+                    m_Refreshed.push_back(static_cast<int>(node));
+                    continue;
+                }
+
+                items.push_back(item);
+                while (node < m_LeafCount)
+                {
+                    size_t next = m_Nodes[2 * node].item == item ? 2 * node : 2 * node + 1;
+                    size_t other = next ^ 1;
+                    if (m_Nodes[other].item != NONE)
+                    {
+                        pushFrontier(other);
+                    }
+                    node = next;
+                }
+            }
+
+            for (int node : m_Refreshed)
+            {
+                replay(node, 1);
+            }
+        }
+    };
+
+}
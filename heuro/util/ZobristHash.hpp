@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Bitset.hpp"
+
+#include <cstdint>
+
+namespace Heuro
+{
+
+    /**
+     * @brief Zobrist hashing of sets of subsets: the hash of a set is the XOR of a random 64-bit key per selected subset,
+     * so selecting or deselecting a subset updates it in O(1), and the empty set hashes to 0.
+     * The keys are a fixed function of the subset ID, so hashes agree across solvers, threads and runs over the same instance.
+     */
+    class ZobristHash
+    {
+    public:
+        /**
+         * @brief The key of a subset, drawn from the splitmix64 sequence.
+         */
+        static uint64_t key(uint64_t subset)
+        {
+            uint64_t z = (subset + 1) * 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * @brief Hashes the subsets set in a bitset from scratch.
+         */
+        static uint64_t of(const Bitset &subsets)
+        {
+            uint64_t hash = 0;
+            subsets.forEachSetBit([&hash](size_t subset) { hash ^= key(subset); });
+            return hash;
+        }
+    };
+
+}
@@ -5,8 +5,9 @@
 ExcelFile::ExcelFile(std::string filename, const std::string &defaultSheetTitle)
     : m_Filename(std::move(filename))
 {
-    m_Workbook.active_sheet().title(defaultSheetTitle);
-    m_ActiveRowPerSheet[defaultSheetTitle] = 0;
+    xlnt::worksheet worksheet = m_Workbook.active_sheet();
+    worksheet.title(defaultSheetTitle);
+    m_Sheets[defaultSheetTitle] = { worksheet };
 }
 
 ExcelFile::~ExcelFile()
@@ -14,19 +15,24 @@ ExcelFile::~ExcelFile()
     m_Workbook.save(m_Filename);
 }
 
+bool ExcelFile::hasSheet(const std::string &title) const
+{
+    return m_Sheets.count(title) > 0;
+}
+
 void ExcelFile::addSheet(const std::string &title)
 {
-    m_Workbook.create_sheet().title(title);
-    m_ActiveRowPerSheet[title] = 0;
+    xlnt::worksheet worksheet = m_Workbook.create_sheet();
+    worksheet.title(title);
+    m_Sheets[title] = { worksheet };
 }
 
 void ExcelFile::addValues(const std::string &sheetTitle, const std::vector<int> &values)
 {
-    xlnt::worksheet ws = m_Workbook.sheet_by_title(sheetTitle);
+    Sheet &sheet = m_Sheets.at(sheetTitle);
     for (size_t i = 0; i < values.size(); ++i)
     {
-        ws.cell(xlnt::cell_reference(i + 1, m_ActiveRowPerSheet[sheetTitle] + 1)).value(values[i]);
+        sheet.worksheet.cell(xlnt::cell_reference(i + 1, sheet.activeRow + 1)).value(values[i]);
     }
-    m_ActiveRowPerSheet[sheetTitle] += 1;
+    sheet.activeRow += 1;
 }
-
@@ -5,16 +5,21 @@
 class ExcelFile
 {
 private:
+    struct Sheet
+    {
+        xlnt::worksheet worksheet;
+        int activeRow = 0;
+    };
+
     std::string m_Filename;
     xlnt::workbook m_Workbook;
-    std::unordered_map<std::string, int> m_ActiveRowPerSheet;
+    std::unordered_map<std::string, Sheet> m_Sheets;
 
 public:
     ExcelFile(std::string filename, const std::string &defaultSheetTitle);
     ~ExcelFile();
 
+    bool hasSheet(const std::string &title) const;
     void addSheet(const std::string &title);
     void addValues(const std::string &sheetTitle, const std::vector<int> &values);
 };
-
-
@@ -1,11 +1,26 @@
 #include "HeuroCli.hpp"
 
-int main()
+#include <iostream>
+
+int main(int argc, char **argv)
 {
-    HeuroCli heuroCli("SCP_RafaelVillegas.xlsx");
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <experiment spec>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        HeuroCli heuroCli(argv[1]);
 
-    heuroCli.run();
+        heuroCli.run();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     return 0;
 }
-
@@ -0,0 +1,392 @@
+#include "RegressionSuite.hpp"
+
+#include "experiment/ExperimentRunner.hpp"
+#include "experiment/JsonLine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace Regress
+{
+
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    static double median(std::vector<double> values)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+    }
+
+    // the first time the run's best cost reached the target, falling back to its end for runs that record no improvements
+    static double timeToTarget(const ResultRecord &run, int targetCost)
+    {
+        for (const CostImprovement &improvement : run.improvements)
+        {
+            if (improvement.bestCost <= targetCost)
+            {
+                return improvement.elapsedMillis;
+            }
+        }
+        return run.cost <= targetCost ? run.wallMillis : INF;
+    }
+
+    static std::vector<double> costsOf(const std::vector<const ResultRecord *> &runs)
+    {
+        std::vector<double> costs;
+        for (const ResultRecord *run : runs)
+        {
+            costs.push_back(run->cost);
+        }
+        return costs;
+    }
+
+    static std::vector<double> timesToTarget(const std::vector<const ResultRecord *> &runs, int targetCost)
+    {
+        std::vector<double> times;
+        for (const ResultRecord *run : runs)
+        {
+            times.push_back(timeToTarget(*run, targetCost));
+        }
+        return times;
+    }
+
+    RankTest mannWhitney(const std::vector<double> &sample, const std::vector<double> &baseline)
+    {
+        if (sample.empty() || baseline.empty())
+        {
+            return {};
+        }
+
+        std::vector<std::pair<double, bool>> pooled; // (value, from the sample)
+        for (double value : sample)
+        {
+            pooled.emplace_back(value, true);
+        }
+        for (double value : baseline)
+        {
+            pooled.emplace_back(value, false);
+        }
+        std::sort(pooled.begin(), pooled.end());
+
+        // tied values share the mean of their ranks
+        double sampleRankSum = 0.0;
+        double tieTerm = 0.0;
+        for (size_t begin = 0; begin < pooled.size();)
+        {
+            size_t end = begin;
+            while (end < pooled.size() && pooled[end].first == pooled[begin].first)
+            {
+                end += 1;
+            }
+            double rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                sampleRankSum += pooled[i].second ? rank : 0.0;
+            }
+            double tied = static_cast<double>(end - begin);
+            tieTerm += tied * tied * tied - tied;
+            begin = end;
+        }
+
+        double n1 = static_cast<double>(sample.size());
+        double n2 = static_cast<double>(baseline.size());
+        double n = n1 + n2;
+        double u = sampleRankSum - n1 * (n1 + 1.0) / 2.0;
+        double mean = n1 * n2 / 2.0;
+        double variance = n1 * n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+
+        RankTest test;
+        test.shift = u / (n1 * n2) - 0.5;
+        if (variance > 0.0)
+        {
+            double z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+            test.p = std::erfc(z / std::sqrt(2.0));
+        }
+        return test;
+    }
+
+    RegressionSuite::RegressionSuite(ExperimentSpec spec, double alpha, double timeTolerance)
+        : m_Spec(std::move(spec)), m_Alpha(alpha), m_TimeTolerance(timeTolerance)
+    {
+        if (m_Spec.instances.empty())
+        {
+            for (const auto &entry : std::filesystem::directory_iterator(m_Spec.assetsDir))
+            {
+                if (entry.path().extension() == ".txt")
+                {
+                    m_Spec.instances.push_back(entry.path().stem().string());
+                }
+            }
+            std::sort(m_Spec.instances.begin(), m_Spec.instances.end());
+        }
+        // no output to find finished jobs in, so every job runs
+        m_Spec.outputPath.clear();
+    }
+
+    std::vector<ResultRecord> RegressionSuite::run()
+    {
+        CollectingSink sink;
+        ExperimentRunner runner(m_Spec, sink);
+        runner.setRecordImprovements(true);
+        runner.run();
+
+        std::vector<ResultRecord> runs = sink.takeRecords();
+        std::sort(runs.begin(), runs.end(), [](const ResultRecord &first, const ResultRecord &second)
+        {
+            return std::tie(first.instance, first.algorithm, first.params, first.seed)
+                < std::tie(second.instance, second.algorithm, second.params, second.seed);
+        });
+        return runs;
+    }
+
+    std::vector<GroupReport> RegressionSuite::compare(const std::vector<ResultRecord> &runs, const std::vector<ResultRecord> &baseline) const
+    {
+        using GroupKey = std::tuple<std::string, std::string, std::string>;
+        std::map<GroupKey, std::vector<const ResultRecord *>> groups;
+        std::map<GroupKey, std::vector<const ResultRecord *>> baselineGroups;
+        for (const ResultRecord &run : runs)
+        {
+            groups[{ run.instance, run.algorithm, run.params }].push_back(&run);
+        }
+        for (const ResultRecord &run : baseline)
+        {
+            baselineGroups[{ run.instance, run.algorithm, run.params }].push_back(&run);
+        }
+
+        std::vector<GroupReport> reports;
+        for (const auto &[key, group] : groups)
+        {
+            GroupReport report;
+            std::tie(report.instance, report.algorithm, report.params) = key;
+            report.runCount = static_cast<int>(group.size());
+
+            std::vector<double> costs = costsOf(group);
+            report.bestCost = static_cast<int>(*std::min_element(costs.begin(), costs.end()));
+            for (double cost : costs)
+            {
+                report.meanCost += cost / static_cast<double>(costs.size());
+            }
+            for (double cost : costs)
+            {
+                report.stddevCost += (cost - report.meanCost) * (cost - report.meanCost);
+            }
+            report.stddevCost = costs.size() > 1 ? std::sqrt(report.stddevCost / static_cast<double>(costs.size() - 1)) : 0.0;
+
+            if (std::all_of(group.begin(), group.end(), [](const ResultRecord *run) { return run->evaluations && run->wallMillis > 0.0; }))
+            {
+                double evaluationsPerSecond = 0.0;
+                for (const ResultRecord *run : group)
+                {
+                    evaluationsPerSecond += static_cast<double>(*run->evaluations) / (run->wallMillis / 1000.0);
+                }
+                report.evaluationsPerSecond = evaluationsPerSecond / static_cast<double>(group.size());
+            }
+
+            auto baselineGroup = baselineGroups.find(key);
+            report.hasBaseline = baselineGroup != baselineGroups.end();
+            std::vector<double> baselineCosts = report.hasBaseline ? costsOf(baselineGroup->second) : std::vector<double>();
+            report.targetCost = static_cast<int>(std::floor(median(report.hasBaseline ? baselineCosts : costs)));
+
+            std::vector<double> times = timesToTarget(group, report.targetCost);
+            report.reachedCount = static_cast<int>(std::count_if(times.begin(), times.end(), [](double time) { return time < INF; }));
+            report.medianTimeToTarget = median(times);
+
+            if (report.hasBaseline)
+            {
+                std::vector<double> baselineTimes = timesToTarget(baselineGroup->second, report.targetCost);
+                report.baselineMeanCost = 0.0;
+                for (double cost : baselineCosts)
+                {
+                    report.baselineMeanCost += cost / static_cast<double>(baselineCosts.size());
+                }
+                report.baselineMedianTimeToTarget = median(baselineTimes);
+
+                // larger costs and times are worse
+                report.costTest = mannWhitney(costs, baselineCosts);
+                report.timeTest = mannWhitney(times, baselineTimes);
+                report.costRegressed = report.costTest.p < m_Alpha && report.costTest.shift > 0.0;
+                report.timeRegressed = report.timeTest.p < m_Alpha && report.timeTest.shift > 0.0
+                    && report.medianTimeToTarget > report.baselineMedianTimeToTarget * (1.0 + m_TimeTolerance);
+            }
+            reports.push_back(std::move(report));
+        }
+        return reports;
+    }
+
+    static std::string formatMillis(double millis)
+    {
+        if (millis == INF)
+        {
+            return "-";
+        }
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(millis < 10.0 ? 2 : 0) << millis;
+        return text.str();
+    }
+
+    void RegressionSuite::printReport(std::ostream &os, const std::vector<GroupReport> &reports)
+    {
+        os << std::left << std::setw(10) << "instance" << std::setw(20) << "algorithm" << std::right << std::setw(5) << "runs"
+           << std::setw(7) << "best" << std::setw(10) << "mean" << std::setw(8) << "stddev" << std::setw(10) << "base" << std::setw(8) << "p"
+           << std::setw(8) << "target" << std::setw(8) << "reached" << std::setw(10) << "ttt ms" << std::setw(10) << "base ttt" << std::setw(8) << "p"
+           << std::setw(12) << "evals/s" << "  " << std::left << std::setw(11) << "verdict" << "params\n";
+
+        int regressionCount = 0;
+        for (const GroupReport &report : reports)
+        {
+            std::string verdict = "new";
+            if (report.hasBaseline)
+            {
+                verdict = report.costRegressed && report.timeRegressed ? "WORSE c+t"
+                    : report.costRegressed                             ? "WORSE cost"
+                    : report.timeRegressed                             ? "WORSE time"
+                                                                       : "ok";
+                regressionCount += report.costRegressed || report.timeRegressed;
+            }
+
+            os << std::left << std::setw(10) << report.instance << std::setw(20) << report.algorithm << std::right << std::setw(5) << report.runCount
+               << std::setw(7) << report.bestCost << std::fixed << std::setprecision(1) << std::setw(10) << report.meanCost
+               << std::setw(8) << report.stddevCost;
+            if (report.hasBaseline)
+            {
+                os << std::setw(10) << report.baselineMeanCost << std::setprecision(3) << std::setw(8) << report.costTest.p;
+            }
+            else
+            {
+                os << std::setw(10) << "-" << std::setw(8) << "-";
+            }
+            os << std::setw(8) << report.targetCost
+               << std::setw(8) << (std::to_string(report.reachedCount) + "/" + std::to_string(report.runCount))
+               << std::setw(10) << formatMillis(report.medianTimeToTarget);
+            if (report.hasBaseline)
+            {
+                os << std::setw(10) << formatMillis(report.baselineMedianTimeToTarget) << std::setprecision(3) << std::setw(8) << report.timeTest.p;
+            }
+            else
+            {
+                os << std::setw(10) << "-" << std::setw(8) << "-";
+            }
+            if (report.evaluationsPerSecond)
+            {
+                os << std::setprecision(0) << std::setw(12) << *report.evaluationsPerSecond;
+            }
+            else
+            {
+                os << std::setw(12) << "-";
+            }
+            os << "  " << std::left << std::setw(11) << verdict << report.params << '\n';
+        }
+        os.unsetf(std::ios::floatfield);
+        os << std::right << reports.size() << " groups, " << regressionCount << " regressions\n";
+    }
+
+    void RegressionSuite::writeRuns(const std::string &filepath, const std::vector<ResultRecord> &runs)
+    {
+        std::ofstream output(filepath);
+        if (!output.is_open())
+        {
+            throw std::runtime_error("Could not open " + filepath);
+        }
+
+        output << std::setprecision(10);
+        for (const ResultRecord &run : runs)
+        {
+            output << "{\"instance\": ";
+            writeJsonString(output, run.instance);
+            output << ", \"algorithm\": ";
+            writeJsonString(output, run.algorithm);
+            output << ", \"params\": ";
+            writeJsonString(output, run.params);
+            output << ", \"seed\": " << run.seed << ", \"cost\": " << run.cost << ", \"subset_count\": " << run.subsetCount
+                   << ", \"wall_ms\": " << run.wallMillis << ", \"evaluations\": ";
+            if (run.evaluations)
+            {
+                output << *run.evaluations;
+            }
+            else
+            {
+                output << "null";
+            }
+            output << ", \"trace_ms\": [";
+            for (size_t i = 0; i < run.improvements.size(); ++i)
+            {
+                output << (i ? ", " : "") << run.improvements[i].elapsedMillis;
+            }
+            output << "], \"trace_cost\": [";
+            for (size_t i = 0; i < run.improvements.size(); ++i)
+            {
+                output << (i ? ", " : "") << run.improvements[i].bestCost;
+            }
+            output << "]}\n";
+        }
+    }
+
+    std::vector<ResultRecord> RegressionSuite::readRuns(const std::string &filepath)
+    {
+        std::ifstream input(filepath);
+        if (!input.is_open())
+        {
+            throw std::runtime_error("Could not open " + filepath);
+        }
+
+        std::vector<ResultRecord> runs;
+        for (std::string line; std::getline(input, line);)
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            ResultRecord run;
+            std::vector<double> traceMillis;
+            std::vector<int> traceCosts;
+            JsonLineReader reader(line);
+            reader.readObject([&](const std::string &name, JsonLineReader &value)
+            {
+                if (name == "instance") run.instance = value.readString();
+                else if (name == "algorithm") run.algorithm = value.readString();
+                else if (name == "params") run.params = value.readString();
+                else if (name == "seed") run.seed = static_cast<uint32_t>(std::stoul(value.readScalar()));
+                else if (name == "cost") run.cost = std::stoi(value.readScalar());
+                else if (name == "subset_count") run.subsetCount = std::stoul(value.readScalar());
+                else if (name == "wall_ms") run.wallMillis = std::stod(value.readScalar());
+                else if (name == "trace_ms") traceMillis = value.readDoubleArray();
+                else if (name == "trace_cost") traceCosts = value.readIntArray();
+                else if (name == "evaluations")
+                {
+                    std::string evaluations = value.readScalar();
+                    if (evaluations != "null")
+                    {
+                        run.evaluations = std::stoull(evaluations);
+                    }
+                }
+                else throw std::runtime_error("Unknown field '" + name + "' in run line");
+            });
+
+            if (traceMillis.size() != traceCosts.size())
+            {
+                throw std::runtime_error("Trace times and costs differ in length in run line: " + line);
+            }
+            for (size_t i = 0; i < traceMillis.size(); ++i)
+            {
+                run.improvements.push_back({ traceMillis[i], traceCosts[i] });
+            }
+            runs.push_back(std::move(run));
+        }
+        return runs;
+    }
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "experiment/ExperimentSpec.hpp"
+#include "experiment/ResultSink.hpp"
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Regress
+{
+
+    /**
+     * @brief Outcome of a two-sided Mann-Whitney U test of a sample against a baseline sample.
+     */
+    struct RankTest
+    {
+        double p = 1.0;
+        double shift = 0.0; // Probability that a sample value exceeds a baseline value (ties count half), minus 0.5
+    };
+
+    /**
+     * @brief Two-sided Mann-Whitney U test, with the normal approximation corrected for ties and continuity.
+     * Infinite values are allowed and rank above every finite one, which suits censored times.
+     */
+    RankTest mannWhitney(const std::vector<double> &sample, const std::vector<double> &baseline);
+
+    /**
+     * @brief The statistics of the runs of one configuration on one instance, and how they compare to the baseline.
+     */
+    struct GroupReport
+    {
+        std::string instance;
+        std::string algorithm;
+        std::string params;
+        int runCount = 0;
+        int bestCost = 0;
+        double meanCost = 0.0;
+        double stddevCost = 0.0;
+        std::optional<double> evaluationsPerSecond; // Only known when the library is built with HE_STATS
+
+        int targetCost = 0; // Median cost of the baseline runs, or of these runs without a baseline
+        int reachedCount = 0; // Runs that reached the target
+        double medianTimeToTarget = 0.0; // Infinite when most runs never reach the target
+
+        bool hasBaseline = false;
+        double baselineMeanCost = 0.0;
+        double baselineMedianTimeToTarget = 0.0;
+        RankTest costTest;
+        RankTest timeTest;
+        bool costRegressed = false;
+        bool timeRegressed = false;
+    };
+
+    /**
+     * @brief Runs an experiment spec a fixed number of times per configuration and instance, and compares the costs and
+     * times to target of the runs with those of a baseline run of the same spec.
+     * The suite never resumes: every job of the spec runs each time, and the spec's output is not used. A spec without
+     * instances runs on every instance of its assets directory.
+     */
+    class RegressionSuite
+    {
+    private:
+        ExperimentSpec m_Spec;
+        double m_Alpha;
+        double m_TimeTolerance;
+
+    public:
+        /**
+         * @param alpha Significance level under which a worse sample is flagged as a regression.
+         * @param timeTolerance Relative slowdown of the median time to target below which a slower sample is not flagged,
+         * since times of a few milliseconds shift with the load of the machine.
+         */
+        explicit RegressionSuite(ExperimentSpec spec, double alpha = 0.05, double timeTolerance = 1.0);
+
+        /**
+         * @return The runs of every job, sorted by job.
+         */
+        std::vector<ResultRecord> run();
+
+        /**
+         * @brief Groups the runs by instance and configuration. Groups missing from the baseline are reported without a
+         * comparison.
+         */
+        std::vector<GroupReport> compare(const std::vector<ResultRecord> &runs, const std::vector<ResultRecord> &baseline) const;
+
+        static void printReport(std::ostream &os, const std::vector<GroupReport> &reports);
+
+        /**
+         * @brief Writes the runs as JSON Lines, improvements included, to be read back as a baseline.
+         */
+        static void writeRuns(const std::string &filepath, const std::vector<ResultRecord> &runs);
+
+        /**
+         * @throws std::runtime_error If the file can not be read or a line can not be parsed.
+         */
+        static std::vector<ResultRecord> readRuns(const std::string &filepath);
+    };
+
+}
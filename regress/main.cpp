@@ -0,0 +1,84 @@
+#include "RegressionSuite.hpp"
+
+#include <iostream>
+
+static const char *USAGE =
+    "Usage: heuro_regress [options] <spec>\n"
+    "  --baseline <file>     Runs of an earlier revision (written with --output) to compare against; exits with 2 on\n"
+    "                        a regression\n"
+    "  --output <file>       Also write the runs as JSON Lines, to be used as a baseline\n"
+    "  --alpha <p>           Significance level of the Mann-Whitney tests (default: 0.05)\n"
+    "  --time-tolerance <r>  Relative slowdown of the median time to target that is never flagged (default: 1, a doubling)\n";
+
+int main(int argc, char **argv)
+{
+    std::string specPath;
+    std::string baselinePath;
+    std::string outputPath;
+    double alpha = 0.05;
+    double timeTolerance = 1.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << arg << '\n' << USAGE;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--baseline") baselinePath = nextValue();
+        else if (arg == "--output") outputPath = nextValue();
+        else if (arg == "--alpha") alpha = std::stod(nextValue());
+        else if (arg == "--time-tolerance") timeTolerance = std::stod(nextValue());
+        else if (specPath.empty() && arg.rfind("--", 0) != 0) specPath = arg;
+        else
+        {
+            std::cerr << USAGE;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (specPath.empty())
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    try
+    {
+        // read the baseline first, so a wrong path fails before the runs
+        std::vector<ResultRecord> baseline;
+        if (!baselinePath.empty())
+        {
+            baseline = Regress::RegressionSuite::readRuns(baselinePath);
+        }
+
+        Regress::RegressionSuite suite(ExperimentSpec::parseFile(specPath), alpha, timeTolerance);
+        std::vector<ResultRecord> runs = suite.run();
+        if (!outputPath.empty())
+        {
+            Regress::RegressionSuite::writeRuns(outputPath, runs);
+        }
+
+        std::vector<Regress::GroupReport> reports = suite.compare(runs, baseline);
+        Regress::RegressionSuite::printReport(std::cout, reports);
+        for (const Regress::GroupReport &report : reports)
+        {
+            if (report.costRegressed || report.timeRegressed)
+            {
+                return 2;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
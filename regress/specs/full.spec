@@ -0,0 +1,32 @@
+# Full tier of the regression suite, every bundled instance (about an hour on one core):
+#   heuro_regress regress/full.spec --output baseline-full.jsonl
+# Time-bounded algorithms depend on the machine, so record the baseline on the machine that runs the comparison.
+assets = assets
+parallelism = 1
+time_budget_ms = 2000
+repetitions = 10
+seed = 1
+
+[constructive]
+
+[grasp]
+maxSolCount = 100
+k = 10
+
+[graspWithNoise]
+maxSolCount = 100
+k = 10
+rho = 5
+
+[simulatedAnnealing]
+initTemp = 10.0
+iterPerTemp = 10
+cooling = linear:0.1
+
+[vns]
+
+[blga]
+populationSize = 150
+matesCount = 10
+geneCopyProbability = 0.8
+rtsSampleSize = 50
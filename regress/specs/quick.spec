@@ -0,0 +1,28 @@
+# Quick tier of the regression suite, a few minutes on one core:
+#   heuro_regress regress/quick.spec --baseline regress/baseline-quick.jsonl
+# The runs are compared with the baseline by configuration, so a baseline only holds for the same spec.
+assets = assets
+parallelism = 1
+time_budget_ms = 500
+instances = scp41, scp42, scpnrg1, scpnrh1
+repetitions = 5
+seed = 1
+
+[constructive]
+
+[grasp]
+maxSolCount = 20
+k = 10
+
+[simulatedAnnealing]
+initTemp = 10.0
+iterPerTemp = 10
+cooling = linear:0.1
+
+[vns]
+
+[blga]
+populationSize = 150
+matesCount = 10
+geneCopyProbability = 0.8
+rtsSampleSize = 50
@@ -0,0 +1,64 @@
+#include <ScpSolver.hpp>
+#include <util/ScpParser.hpp>
+#include <util/ScratchArena.hpp>
+
+#include <iostream>
+#include <string>
+
+static int s_Failures = 0;
+
+static void check(bool condition, const std::string &what)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << what << '\n';
+        s_Failures += 1;
+    }
+}
+
+// resetting the stats in the middle of an iteration must not make the next reset see a negative overflow
+static void resetStatsThenReset()
+{
+    Heuro::ScratchArena arena(64);
+    check(arena.resource()->allocate(1024) != nullptr, "the arena allocates past its buffer");
+    arena.resetStats();
+    arena.reset();
+    check(arena.stats().allocatedBytes > 0, "the overflowing iteration enlarges the buffer");
+
+    arena.resetStats();
+    check(arena.resource()->allocate(1024) != nullptr, "the arena allocates again");
+    arena.reset();
+    check(arena.stats().allocatedBytes == 0, "an iteration of the same size fits in the enlarged buffer");
+}
+
+// the way a caller measures the scratch memory of a run: reset the stats, solve, read them
+static void resetStatsThenSolve(const std::string &instancePath)
+{
+    auto solver = Heuro::ScpSolver::create(Heuro::ScpParser::parseFile(instancePath));
+    solver->grasp(2, 10);
+
+    solver->resetScratchMemoryStats();
+    check(solver->grasp(2, 10).cost > 0, "GRASP solves after the stats are reset");
+
+    solver->resetScratchMemoryStats();
+    check(solver->blga(50, 20, 4, 0.8, 10).cost > 0, "BLGA solves after the stats are reset");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: heuro_test_scratch_arena <instance file>\n";
+        return 1;
+    }
+
+    resetStatsThenReset();
+    resetStatsThenSolve(argv[1]);
+
+    if (s_Failures > 0)
+    {
+        return 1;
+    }
+    std::cout << "All scratch arena tests passed\n";
+    return 0;
+}
@@ -0,0 +1,446 @@
+#include "RaceTuner.hpp"
+
+#include "experiment/ExperimentRunner.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace Tune
+{
+
+    static constexpr int MAX_ITERATIONS = 300;
+    static constexpr double EPSILON = 1e-14;
+    static constexpr double TINY = 1e-300;
+
+    // upper regularized incomplete gamma function Q(a, x), by its series below a + 1 and its continued fraction above
+    static double upperGamma(double a, double x)
+    {
+        if (x <= 0.0)
+        {
+            return 1.0;
+        }
+        double front = std::exp(-x + a * std::log(x) - std::lgamma(a));
+        if (x < a + 1.0)
+        {
+            double term = 1.0 / a;
+            double sum = term;
+            for (int n = 1; n < MAX_ITERATIONS && std::abs(term) > std::abs(sum) * EPSILON; ++n)
+            {
+                term *= x / (a + n);
+                sum += term;
+            }
+            return std::max(0.0, 1.0 - sum * front);
+        }
+
+        // modified Lentz's method
+        double b = x + 1.0 - a;
+        double c = 1.0 / TINY;
+        double d = 1.0 / b;
+        double h = d;
+        for (int i = 1; i < MAX_ITERATIONS; ++i)
+        {
+            double an = -i * (i - a);
+            b += 2.0;
+            d = an * d + b;
+            d = std::abs(d) < TINY ? TINY : d;
+            c = b + an / c;
+            c = std::abs(c) < TINY ? TINY : c;
+            d = 1.0 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::abs(delta - 1.0) < EPSILON)
+            {
+                break;
+            }
+        }
+        return front * h;
+    }
+
+    // continued fraction of the regularized incomplete beta function, converging for x < (a + 1) / (a + b + 2)
+    static double betaFraction(double a, double b, double x)
+    {
+        double c = 1.0;
+        double d = 1.0 - (a + b) * x / (a + 1.0);
+        d = std::abs(d) < TINY ? TINY : d;
+        d = 1.0 / d;
+        double h = d;
+        for (int m = 1; m < MAX_ITERATIONS; ++m)
+        {
+            double aa = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+            d = 1.0 + aa * d;
+            d = std::abs(d) < TINY ? TINY : d;
+            c = 1.0 + aa / c;
+            c = std::abs(c) < TINY ? TINY : c;
+            d = 1.0 / d;
+            h *= d * c;
+
+            aa = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+            d = 1.0 + aa * d;
+            d = std::abs(d) < TINY ? TINY : d;
+            c = 1.0 + aa / c;
+            c = std::abs(c) < TINY ? TINY : c;
+            d = 1.0 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::abs(delta - 1.0) < EPSILON)
+            {
+                break;
+            }
+        }
+        return h;
+    }
+
+    // regularized incomplete beta function I_x(a, b)
+    static double incompleteBeta(double a, double b, double x)
+    {
+        if (x <= 0.0 || x >= 1.0)
+        {
+            return x <= 0.0 ? 0.0 : 1.0;
+        }
+        double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x));
+        return x < (a + 1.0) / (a + b + 2.0)
+            ? front * betaFraction(a, b, x) / a
+            : 1.0 - front * betaFraction(b, a, 1.0 - x) / b;
+    }
+
+    static double chiSquaredSurvival(double x, double degrees)
+    {
+        return upperGamma(degrees / 2.0, x / 2.0);
+    }
+
+    // two-sided p-value of Student's t distribution
+    static double studentTwoSided(double t, double degrees)
+    {
+        return incompleteBeta(degrees / 2.0, 0.5, degrees / (degrees + t * t));
+    }
+
+    // ranks of the values from 1, ties sharing the mean of their ranks
+    static std::vector<double> ranksOf(const std::vector<double> &values)
+    {
+        std::vector<size_t> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&values](size_t i, size_t j) { return values[i] < values[j]; });
+
+        std::vector<double> ranks(values.size());
+        for (size_t begin = 0; begin < order.size();)
+        {
+            size_t end = begin;
+            while (end < order.size() && values[order[end]] == values[order[begin]])
+            {
+                end += 1;
+            }
+            double rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                ranks[order[i]] = rank;
+            }
+            begin = end;
+        }
+        return ranks;
+    }
+
+    FriedmanTest friedman(const std::vector<std::vector<double>> &costs)
+    {
+        FriedmanTest test;
+        if (costs.empty())
+        {
+            return test;
+        }
+
+        const double b = static_cast<double>(costs.size());
+        const size_t configCount = costs.front().size();
+        const double k = static_cast<double>(configCount);
+        test.rankSums.assign(configCount, 0.0);
+        test.pVersusBest.assign(configCount, 1.0);
+        double squaredRanks = 0.0;
+        for (const std::vector<double> &block : costs)
+        {
+            std::vector<double> ranks = ranksOf(block);
+            for (size_t j = 0; j < configCount; ++j)
+            {
+                test.rankSums[j] += ranks[j];
+                squaredRanks += ranks[j] * ranks[j];
+            }
+        }
+        test.best = std::min_element(test.rankSums.begin(), test.rankSums.end()) - test.rankSums.begin();
+        if (configCount < 2)
+        {
+            return test;
+        }
+
+        // with no ties at all, the denominator is b k (k + 1) (k - 1) / 12
+        double tiesTerm = squaredRanks - b * k * (k + 1.0) * (k + 1.0) / 4.0;
+        if (tiesTerm <= 0.0)
+        {
+            return test; // every block ties every configuration
+        }
+        double spread = 0.0;
+        for (double rankSum : test.rankSums)
+        {
+            spread += (rankSum - b * (k + 1.0) / 2.0) * (rankSum - b * (k + 1.0) / 2.0);
+        }
+        double statistic = (k - 1.0) * spread / tiesTerm;
+        test.p = chiSquaredSurvival(statistic, k - 1.0);
+
+        if (costs.size() < 2)
+        {
+            return test;
+        }
+        double degrees = (b - 1.0) * (k - 1.0);
+        double scale = 2.0 * b * tiesTerm / degrees * (1.0 - statistic / (b * (k - 1.0)));
+        for (size_t j = 0; j < configCount; ++j)
+        {
+            double difference = std::abs(test.rankSums[j] - test.rankSums[test.best]);
+            if (j == test.best || difference == 0.0)
+            {
+                continue;
+            }
+            // the blocks agree perfectly, so any difference is significant
+            test.pVersusBest[j] = scale > 0.0 ? studentTwoSided(difference / std::sqrt(scale), degrees) : 0.0;
+        }
+        return test;
+    }
+
+    RaceTuner::RaceTuner(ExperimentSpec spec, long budget, double alpha, int firstTest)
+        : m_Spec(std::move(spec)), m_Budget(budget), m_Alpha(alpha), m_FirstTest(std::max(firstTest, 1))
+    {
+        if (m_Spec.instances.empty())
+        {
+            for (const auto &entry : std::filesystem::directory_iterator(m_Spec.assetsDir))
+            {
+                if (entry.path().extension() == ".txt")
+                {
+                    m_Spec.instances.push_back(entry.path().stem().string());
+                }
+            }
+            std::sort(m_Spec.instances.begin(), m_Spec.instances.end());
+        }
+        if (m_Spec.configs.empty())
+        {
+            throw std::runtime_error("The spec has no configurations to race");
+        }
+        // no output to find finished jobs in, so every stage runs
+        m_Spec.outputPath.clear();
+    }
+
+    std::string RaceTuner::instanceClass(const std::string &instance)
+    {
+        size_t end = instance.size();
+        while (end > 0 && std::isdigit(static_cast<unsigned char>(instance[end - 1])))
+        {
+            end -= 1;
+        }
+        if (end == 0)
+        {
+            return instance;
+        }
+        // OR-Library numbers its classes 4 to 6 by the first digit, e.g. scp41 to scp410 make class scp4
+        bool isNumberedClass = instance.size() - end >= 2;
+        return instance.substr(0, isNumberedClass ? end + 1 : end);
+    }
+
+    ClassRace RaceTuner::race(const std::string &instanceClass, const std::vector<std::string> &instances, long budget, std::ostream &log) const
+    {
+        const std::vector<AlgorithmConfig> &candidates = m_Spec.configs;
+        std::map<std::string, size_t> candidateIndexes;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            candidateIndexes[candidates[i].algorithm + '|' + candidates[i].paramsKey()] = i;
+        }
+
+        unsigned int workerCount = m_Spec.parallelism > 0 ? m_Spec.parallelism : std::max(1u, std::thread::hardware_concurrency());
+        uint32_t nextSeed = m_Spec.seeds.empty() ? 1 : m_Spec.seeds.front();
+
+        ClassRace race{
+            .instanceClass = instanceClass,
+            .instances = instances,
+            .candidateCount = candidates.size(),
+            .blockCount = 0,
+            .runCount = 0,
+            .survivors = {},
+            .meanRanks = {},
+        };
+        std::vector<size_t> alive(candidates.size());
+        std::iota(alive.begin(), alive.end(), 0);
+        std::vector<std::vector<double>> blockCosts; // Cost of every candidate in each block, NaN once dropped
+        while (alive.size() > 1)
+        {
+            // enough seeds to reach the first test, and to keep every worker busy
+            long runsPerSeed = static_cast<long>(alive.size() * instances.size());
+            long seedCount = std::max<long>(1, (static_cast<long>(workerCount) + runsPerSeed - 1) / runsPerSeed);
+            if (blockCosts.empty())
+            {
+                seedCount = std::max<long>(seedCount, (m_FirstTest + static_cast<long>(instances.size()) - 1) / static_cast<long>(instances.size()));
+            }
+            seedCount = std::min(seedCount, (budget - race.runCount) / runsPerSeed);
+            if (seedCount == 0)
+            {
+                break;
+            }
+
+            ExperimentSpec stage = m_Spec;
+            stage.instances = instances;
+            stage.seeds.clear();
+            std::map<std::pair<std::string, uint32_t>, size_t> blockIndexes;
+            for (long s = 0; s < seedCount; ++s, ++nextSeed)
+            {
+                stage.seeds.push_back(nextSeed);
+                for (const std::string &instance : instances)
+                {
+                    blockIndexes[{ instance, nextSeed }] = blockCosts.size();
+                    blockCosts.emplace_back(candidates.size(), std::numeric_limits<double>::quiet_NaN());
+                }
+            }
+            stage.configs.clear();
+            for (size_t i : alive)
+            {
+                stage.configs.push_back(candidates[i]);
+            }
+
+            CollectingSink sink;
+            ExperimentRunner runner(stage, sink);
+            race.runCount += static_cast<long>(runner.run());
+            for (const ResultRecord &record : sink.takeRecords())
+            {
+                blockCosts[blockIndexes.at({ record.instance, record.seed })][candidateIndexes.at(record.algorithm + '|' + record.params)] = record.cost;
+            }
+            race.blockCount = static_cast<int>(blockCosts.size());
+            if (race.blockCount < m_FirstTest)
+            {
+                continue;
+            }
+
+            std::vector<std::vector<double>> aliveCosts;
+            for (const std::vector<double> &block : blockCosts)
+            {
+                std::vector<double> &costs = aliveCosts.emplace_back();
+                for (size_t i : alive)
+                {
+                    costs.push_back(block[i]);
+                }
+            }
+            FriedmanTest test = friedman(aliveCosts);
+            std::vector<size_t> survivors;
+            for (size_t j = 0; j < alive.size(); ++j)
+            {
+                bool isWorse = test.p < m_Alpha && test.pVersusBest[j] < m_Alpha;
+                if (isWorse)
+                {
+                    for (std::vector<double> &block : blockCosts)
+                    {
+                        block[alive[j]] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                }
+                else
+                {
+                    survivors.push_back(alive[j]);
+                }
+            }
+            log << instanceClass << ": " << race.blockCount << " blocks, " << race.runCount << " runs, Friedman p = " << std::setprecision(3)
+                << test.p << ", " << survivors.size() << " of " << alive.size() << " configurations left" << std::endl;
+            alive = std::move(survivors);
+        }
+
+        if (blockCosts.empty())
+        {
+            throw std::runtime_error("The budget of class " + instanceClass + " does not cover one run of every configuration on each of its instances");
+        }
+
+        // the survivors, best mean rank first
+        std::vector<std::vector<double>> aliveCosts;
+        for (const std::vector<double> &block : blockCosts)
+        {
+            std::vector<double> &costs = aliveCosts.emplace_back();
+            for (size_t i : alive)
+            {
+                costs.push_back(block[i]);
+            }
+        }
+        FriedmanTest test = friedman(aliveCosts);
+        std::vector<size_t> order(alive.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&test](size_t i, size_t j) { return test.rankSums[i] < test.rankSums[j]; });
+        for (size_t j : order)
+        {
+            race.survivors.push_back(candidates[alive[j]]);
+            race.meanRanks.push_back(test.rankSums[j] / static_cast<double>(blockCosts.size()));
+        }
+        return race;
+    }
+
+    std::vector<ClassRace> RaceTuner::run(std::ostream &log)
+    {
+        std::map<std::string, std::vector<std::string>> classes;
+        for (const std::string &instance : m_Spec.instances)
+        {
+            classes[instanceClass(instance)].push_back(instance);
+        }
+
+        std::vector<ClassRace> races;
+        long classIndex = 0;
+        for (const auto &[name, instances] : classes)
+        {
+            // the first classes take the remainder of the budget
+            long classCount = static_cast<long>(classes.size());
+            long budget = m_Budget / classCount + (classIndex < m_Budget % classCount ? 1 : 0);
+            races.push_back(race(name, instances, budget, log));
+            classIndex += 1;
+        }
+        return races;
+    }
+
+    void RaceTuner::printResults(std::ostream &os, const std::vector<ClassRace> &races)
+    {
+        os << std::left << std::setw(10) << "class" << std::right << std::setw(8) << "blocks" << std::setw(8) << "runs" << std::setw(8) << "left"
+           << std::setw(10) << "mean rank" << "  " << std::left << std::setw(20) << "algorithm" << "params\n";
+        for (const ClassRace &race : races)
+        {
+            for (size_t i = 0; i < race.survivors.size(); ++i)
+            {
+                std::string left = std::to_string(race.survivors.size()) + "/" + std::to_string(race.candidateCount);
+                os << std::left << std::setw(10) << (i == 0 ? race.instanceClass : "") << std::right << std::setw(8) << (i == 0 ? std::to_string(race.blockCount) : "")
+                   << std::setw(8) << (i == 0 ? std::to_string(race.runCount) : "") << std::setw(8) << (i == 0 ? left : "")
+                   << std::fixed << std::setprecision(2) << std::setw(10) << race.meanRanks[i] << "  " << std::left << std::setw(20)
+                   << race.survivors[i].algorithm << race.survivors[i].paramsKey() << '\n';
+            }
+        }
+        os.unsetf(std::ios::floatfield);
+        os << std::right;
+    }
+
+    void RaceTuner::writeSpec(const std::string &filepath, const std::vector<ClassRace> &races)
+    {
+        std::ofstream output(filepath);
+        if (!output.is_open())
+        {
+            throw std::runtime_error("Could not open " + filepath);
+        }
+
+        output << "# Best configuration of every instance class, raced by heuro_tune\n";
+        for (const ClassRace &race : races)
+        {
+            const AlgorithmConfig &best = race.survivors.front();
+            output << "\n# class " << race.instanceClass << ": mean rank " << std::setprecision(3) << race.meanRanks.front() << " over "
+                   << race.blockCount << " blocks, " << race.survivors.size() << " of " << race.candidateCount << " configurations left\n";
+            output << '[' << best.algorithm << "]\n";
+            for (const auto &[name, value] : best.params)
+            {
+                output << name << " = " << value << '\n';
+            }
+        }
+        if (!output.flush())
+        {
+            throw std::runtime_error("Could not write " + filepath);
+        }
+    }
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "experiment/ExperimentSpec.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Tune
+{
+
+    /**
+     * @brief Outcome of a Friedman test over blocks of runs, each block holding one cost per configuration, and of the
+     * Conover post-hoc comparisons of every configuration with the best one.
+     */
+    struct FriedmanTest
+    {
+        double p = 1.0; // Of every configuration performing alike
+        std::vector<double> rankSums; // Of the ranks of each configuration within the blocks, the lowest cost ranking 1
+        size_t best = 0; // The configuration of lowest rank sum
+        std::vector<double> pVersusBest; // Of each configuration performing like the best one, 1 for the best itself
+    };
+
+    /**
+     * @brief Friedman test with ties ranked by their mean rank, using the chi-squared approximation, followed by the Conover
+     * post-hoc test (as used by F-race) when there are at least two blocks.
+     *
+     * @param costs The cost of every configuration in each block.
+     */
+    FriedmanTest friedman(const std::vector<std::vector<double>> &costs);
+
+    /**
+     * @brief The race of one instance class: which configurations survived, and the one that ranked best.
+     */
+    struct ClassRace
+    {
+        std::string instanceClass;
+        std::vector<std::string> instances;
+        size_t candidateCount = 0;
+        int blockCount = 0; // Instance and seed pairs every survivor ran on
+        long runCount = 0;
+        std::vector<AlgorithmConfig> survivors; // Best first
+        std::vector<double> meanRanks; // Of each survivor, among the survivors
+    };
+
+    /**
+     * @brief Tunes the parameters of the algorithms of an experiment spec by racing (F-race): the configurations of the
+     * spec's grids run on one instance and seed after another, and once firstTest of those blocks are done, the ones that a
+     * Friedman test and its post-hoc comparisons find significantly worse than the best are dropped from the race. The
+     * survivors keep running until a single one is left or the budget is spent.
+     * Instances race by class (see instanceClass), each class taking an equal share of the budget. The spec's seed is the
+     * first seed of every race. Each stage runs its jobs on as many workers as the spec's parallelism allows, with enough
+     * seeds at once to keep them busy.
+     */
+    class RaceTuner
+    {
+    private:
+        ExperimentSpec m_Spec;
+        long m_Budget;
+        double m_Alpha;
+        int m_FirstTest;
+
+        ClassRace race(const std::string &instanceClass, const std::vector<std::string> &instances, long budget, std::ostream &log) const;
+
+    public:
+        /**
+         * @param budget The number of runs all the races may take together.
+         * @param alpha Significance level under which a configuration is dropped.
+         * @param firstTest The number of blocks every configuration runs before the first test.
+         */
+        RaceTuner(ExperimentSpec spec, long budget, double alpha = 0.05, int firstTest = 5);
+
+        /**
+         * @brief The class of an instance: its name without the trailing number, or without all but the first digit of a
+         * number of two or more, following the OR-Library names (scp41 to scp410 make class scp4, scpnrg1 to scpnrg5 make
+         * class scpnrg).
+         */
+        static std::string instanceClass(const std::string &instance);
+
+        /**
+         * @brief Races every instance class, reporting the eliminations of each stage to the log.
+         *
+         * @throws std::runtime_error If the budget of a class does not cover a first block of every configuration.
+         */
+        std::vector<ClassRace> run(std::ostream &log);
+
+        static void printResults(std::ostream &os, const std::vector<ClassRace> &races);
+
+        /**
+         * @brief Writes the best configuration of every class as a section of an experiment spec, preceded by a comment
+         * naming its class.
+         */
+        static void writeSpec(const std::string &filepath, const std::vector<ClassRace> &races);
+    };
+
+}
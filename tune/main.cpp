@@ -0,0 +1,81 @@
+#include "RaceTuner.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+static const char *USAGE =
+    "Usage: heuro_tune [options] <spec>\n"
+    "  --budget <runs>     Runs all the races may take together (default: 20 per configuration and instance class)\n"
+    "  --alpha <p>         Significance level under which a configuration is dropped (default: 0.05)\n"
+    "  --first-test <n>    Instance and seed blocks every configuration runs before the first test (default: 5)\n"
+    "  --output <file>     Also write the best configuration of every instance class as a spec\n";
+
+int main(int argc, char **argv)
+{
+    std::string specPath;
+    std::string outputPath;
+    long budget = 0;
+    double alpha = 0.05;
+    int firstTest = 5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << arg << '\n' << USAGE;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--budget") budget = std::stol(nextValue());
+        else if (arg == "--alpha") alpha = std::stod(nextValue());
+        else if (arg == "--first-test") firstTest = std::stoi(nextValue());
+        else if (arg == "--output") outputPath = nextValue();
+        else if (specPath.empty() && arg.rfind("--", 0) != 0) specPath = arg;
+        else
+        {
+            std::cerr << USAGE;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (specPath.empty())
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
+    try
+    {
+        ExperimentSpec spec = ExperimentSpec::parseFile(specPath);
+        if (budget <= 0)
+        {
+            std::vector<std::string> classes;
+            for (const std::string &instance : spec.instances)
+            {
+                classes.push_back(Tune::RaceTuner::instanceClass(instance));
+            }
+            std::sort(classes.begin(), classes.end());
+            long classCount = std::max<long>(1, std::unique(classes.begin(), classes.end()) - classes.begin());
+            budget = 20 * static_cast<long>(spec.configs.size()) * classCount;
+        }
+
+        Tune::RaceTuner tuner(std::move(spec), budget, alpha, firstTest);
+        std::vector<Tune::ClassRace> races = tuner.run(std::cerr);
+        Tune::RaceTuner::printResults(std::cout, races);
+        if (!outputPath.empty())
+        {
+            Tune::RaceTuner::writeSpec(outputPath, races);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+# Races a grid of BLGA configurations on the OR-Library classes 4 and NRG, half a second per run on one core:
+#   heuro_tune tune/blga.spec --budget 400 --output tuned.spec
+# The best configuration of each class is written as a spec section, ready for an experiment.
+assets = assets
+parallelism = 1
+time_budget_ms = 500
+instances = scp41, scp42, scpnrg1, scpnrg2, scpnrg3
+seed = 1
+
+[blga]
+populationSize = 150, 300
+matesCount = 5, 10
+geneCopyProbability = 0.65, 0.8
+rtsSampleSize = 50